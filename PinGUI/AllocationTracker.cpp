@@ -0,0 +1,177 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "AllocationTracker.h"
+
+#include <iostream>
+#include <cstdlib>
+#include <new>
+
+namespace PinGUI{
+
+    std::atomic<std::size_t> AllocationTracker::_allocations[ALLOC_SUBSYSTEM_COUNT];
+
+    std::atomic<std::size_t> AllocationTracker::_bytes[ALLOC_SUBSYSTEM_COUNT];
+
+    std::atomic<std::size_t> AllocationTracker::_lastAllocations[ALLOC_SUBSYSTEM_COUNT];
+
+    std::atomic<std::size_t> AllocationTracker::_lastBytes[ALLOC_SUBSYSTEM_COUNT];
+
+    thread_local allocationSubsystem AllocationTracker::_subsystem = ALLOC_OTHER;
+
+    std::size_t allocationStats::getTotalAllocations() const{
+
+        std::size_t total = 0;
+
+        for (int i = 0; i < ALLOC_SUBSYSTEM_COUNT; i++)
+            total += allocations[i];
+
+        return total;
+    }
+
+    bool AllocationTracker::isEnabled(){
+
+        #ifdef PINGUI_TRACK_ALLOCATIONS
+            return true;
+        #else
+            return false;
+        #endif
+    }
+
+    void AllocationTracker::recordAllocation(std::size_t size){
+
+        _allocations[_subsystem].fetch_add(1,std::memory_order_relaxed);
+        _bytes[_subsystem].fetch_add(size,std::memory_order_relaxed);
+    }
+
+    allocationSubsystem AllocationTracker::setSubsystem(allocationSubsystem subsystem){
+
+        allocationSubsystem tmp = _subsystem;
+        _subsystem = subsystem;
+
+        return tmp;
+    }
+
+    void AllocationTracker::endFrame(){
+
+        for (int i = 0; i < ALLOC_SUBSYSTEM_COUNT; i++){
+
+            _lastAllocations[i].store(_allocations[i].exchange(0,std::memory_order_relaxed),std::memory_order_relaxed);
+            _lastBytes[i].store(_bytes[i].exchange(0,std::memory_order_relaxed),std::memory_order_relaxed);
+        }
+    }
+
+    allocationStats AllocationTracker::getLastFrame(){
+
+        allocationStats stats;
+
+        for (int i = 0; i < ALLOC_SUBSYSTEM_COUNT; i++){
+
+            stats.allocations[i] = _lastAllocations[i].load(std::memory_order_relaxed);
+            stats.bytes[i] = _lastBytes[i].load(std::memory_order_relaxed);
+        }
+
+        return stats;
+    }
+
+    std::size_t AllocationTracker::getCurrentAllocations(allocationSubsystem subsystem){
+        return _allocations[subsystem].load(std::memory_order_relaxed);
+    }
+
+    const char* AllocationTracker::getSubsystemName(allocationSubsystem subsystem){
+
+        switch(subsystem){
+
+            case ALLOC_INPUT: return "input";
+            case ALLOC_UPDATE: return "update";
+            case ALLOC_TEXT: return "text";
+            case ALLOC_RENDER: return "render";
+            default: return "other";
+        }
+    }
+
+    void AllocationTracker::info(){
+
+        allocationStats lastFrame = getLastFrame();
+
+        std::cout << "Allocations in last frame: " << lastFrame.getTotalAllocations() << std::endl;
+
+        for (int i = 0; i < ALLOC_SUBSYSTEM_COUNT; i++){
+
+            std::cout << "  " << getSubsystemName(allocationSubsystem(i)) << ": " << lastFrame.allocations[i]
+                      << " (" << lastFrame.bytes[i] << " bytes)" << std::endl;
+        }
+    }
+}
+
+/**
+    Counting replacements of the global allocation functions
+**/
+#ifdef PINGUI_TRACK_ALLOCATIONS
+
+void* operator new(std::size_t size){
+
+    PinGUI::AllocationTracker::recordAllocation(size);
+
+    if (size == 0)
+        size = 1;
+
+    while (true){
+
+        void* ptr = std::malloc(size);
+
+        if (ptr)
+            return ptr;
+
+        std::new_handler handler = std::get_new_handler();
+
+        if (!handler)
+            throw std::bad_alloc();
+
+        handler();
+    }
+}
+
+void* operator new[](std::size_t size){
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept{
+    std::free(ptr);
+}
+
+#endif // PINGUI_TRACK_ALLOCATIONS
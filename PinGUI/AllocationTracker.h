@@ -0,0 +1,122 @@
+#ifndef ALLOCATIONTRACKER_H
+#define ALLOCATIONTRACKER_H
+
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include <cstddef>
+#include <atomic>
+
+/**
+    Counting of heap allocations per frame, split by the subsystem that made them.
+    The global operator new is replaced only when PINGUI_TRACK_ALLOCATIONS is defined,
+    otherwise all the counters stay at zero.
+    The counters are process-wide like the operator new itself, they aren't a part of PinGUI::Context -
+    with more contexts a frame closed by one of them counts the allocations of all of them.
+**/
+
+namespace PinGUI{
+
+    enum allocationSubsystem{
+        ALLOC_OTHER,
+        ALLOC_INPUT,
+        ALLOC_UPDATE,
+        ALLOC_TEXT,
+        ALLOC_RENDER,
+        ALLOC_SUBSYSTEM_COUNT
+    };
+
+    struct allocationStats{
+
+        std::size_t allocations[ALLOC_SUBSYSTEM_COUNT];
+        std::size_t bytes[ALLOC_SUBSYSTEM_COUNT];
+
+        std::size_t getTotalAllocations() const;
+    };
+
+    class AllocationTracker{
+
+        private:
+
+            static std::atomic<std::size_t> _allocations[ALLOC_SUBSYSTEM_COUNT];
+
+            static std::atomic<std::size_t> _bytes[ALLOC_SUBSYSTEM_COUNT];
+
+            //Counters of the last closed frame, read from any thread
+            static std::atomic<std::size_t> _lastAllocations[ALLOC_SUBSYSTEM_COUNT];
+
+            static std::atomic<std::size_t> _lastBytes[ALLOC_SUBSYSTEM_COUNT];
+
+            //Every thread is counted into the subsystem it is currently working for
+            static thread_local allocationSubsystem _subsystem;
+
+        public:
+
+            static bool isEnabled();
+
+            static void recordAllocation(std::size_t size);
+
+            //Returns the previous subsystem so it can be restored
+            static allocationSubsystem setSubsystem(allocationSubsystem subsystem);
+
+            //Closes the current frame - its counters become the "last frame" stats
+            static void endFrame();
+
+            static allocationStats getLastFrame();
+
+            static std::size_t getCurrentAllocations(allocationSubsystem subsystem);
+
+            static const char* getSubsystemName(allocationSubsystem subsystem);
+
+            //Prints the last frame stats
+            static void info();
+    };
+
+    /**
+        Switches the counted subsystem for the lifetime of the scope
+    **/
+    class AllocationScope{
+
+        private:
+
+            allocationSubsystem _previous;
+
+        public:
+
+            AllocationScope(allocationSubsystem subsystem):
+                _previous(AllocationTracker::setSubsystem(subsystem))
+            {
+            }
+
+            ~AllocationScope(){
+                AllocationTracker::setSubsystem(_previous);
+            }
+
+            AllocationScope(const AllocationScope&) = delete;
+            AllocationScope& operator=(const AllocationScope&) = delete;
+    };
+}
+
+#endif // ALLOCATIONTRACKER_H
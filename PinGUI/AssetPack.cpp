@@ -0,0 +1,312 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "AssetPack.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace PinGUI{
+
+    const uint8_t* AssetPack::_data = nullptr;
+
+    std::size_t AssetPack::_size = 0;
+
+    const packEntry* AssetPack::_ENTRIES = nullptr;
+
+    void* AssetPack::_fileHandle = nullptr;
+
+    void* AssetPack::_mappingHandle = nullptr;
+
+    std::mutex AssetPack::_mutex;
+
+    bool AssetPack::open(const std::string& filePath){
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_data)
+            return true;
+
+        if (!mapFile(filePath))
+            return false;
+
+        if (!validate()){
+
+            unmapFile();
+            return false;
+        }
+
+        _ENTRIES = reinterpret_cast<const packEntry*>(_data + sizeof(packHeader));
+
+        return true;
+    }
+
+    void AssetPack::close(){
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        unmapFile();
+        _ENTRIES = nullptr;
+    }
+
+    bool AssetPack::isOpen(){
+        return _data != nullptr;
+    }
+
+    bool AssetPack::validate(){
+
+        if (_size < sizeof(packHeader))
+            return false;
+
+        const packHeader* header = reinterpret_cast<const packHeader*>(_data);
+
+        if (header->magic != PINGUI_PACK_MAGIC || header->version != PINGUI_PACK_VERSION)
+            return false;
+
+        if (sizeof(packHeader) + std::size_t(header->numOfEntries)*sizeof(packEntry) > _size)
+            return false;
+
+        const packEntry* entries = reinterpret_cast<const packEntry*>(_data + sizeof(packHeader));
+
+        for (uint32_t i = 0; i < header->numOfEntries; i++){
+
+            //Written so a corrupt offset can't overflow past the check
+            if (entries[i].offset > _size || entries[i].size > _size - entries[i].offset)
+                return false;
+        }
+
+        return true;
+    }
+
+    const packEntry* AssetPack::findEntry(packEntryType type, uint32_t id){
+
+        if (!_data)
+            return nullptr;
+
+        uint32_t numOfEntries = reinterpret_cast<const packHeader*>(_data)->numOfEntries;
+
+        for (uint32_t i = 0; i < numOfEntries; i++){
+
+            if (_ENTRIES[i].type == uint32_t(type) && _ENTRIES[i].id == id)
+                return &_ENTRIES[i];
+        }
+
+        return nullptr;
+    }
+
+    const uint8_t* AssetPack::getEntryData(const packEntry* entry){
+        return _data + entry->offset;
+    }
+
+    uint32_t AssetPack::getNumOfSurfaces(){
+
+        if (!_data)
+            return 0;
+
+        return reinterpret_cast<const packHeader*>(_data)->numOfSurfaces;
+    }
+
+    bool AssetPack::getGlyphAtlas(int fontSize, glyphAtlasView& view){
+
+        const packEntry* entry = findEntry(PACK_GLYPH_ATLAS,uint32_t(fontSize));
+
+        if (!entry)
+            return false;
+
+        if (entry->size < sizeof(packGlyphAtlas))
+            return false;
+
+        const uint8_t* data = getEntryData(entry);
+
+        view.info = reinterpret_cast<const packGlyphAtlas*>(data);
+        view.glyphs = reinterpret_cast<const packGlyph*>(data + sizeof(packGlyphAtlas));
+        view.width = int(entry->width);
+        view.height = int(entry->height);
+
+        uint64_t pixelsOffset = alignOffset(sizeof(packGlyphAtlas) + std::size_t(view.info->numOfGlyphs)*sizeof(packGlyph));
+
+        if (pixelsOffset + uint64_t(entry->width)*entry->height*4 > entry->size)
+            return false;
+
+        view.pixels = data + pixelsOffset;
+
+        return true;
+    }
+
+    SDL_Surface* AssetPack::createGlyphSurface(int fontSize, char ch, SDL_Color color){
+
+        glyphAtlasView view;
+
+        if (!getGlyphAtlas(fontSize,view))
+            return nullptr;
+
+        uint32_t code = static_cast<unsigned char>(ch);
+
+        if (code < view.info->firstChar || code - view.info->firstChar >= view.info->numOfGlyphs)
+            return nullptr;
+
+        const packGlyph& glyph = view.glyphs[code - view.info->firstChar];
+
+        if (glyph.w == 0 || glyph.h == 0 || glyph.x + glyph.w > view.width || glyph.y + glyph.h > view.height)
+            return nullptr;
+
+        //Same format as the surfaces of TTF_RenderText_Blended
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0,glyph.w,glyph.h,32,SDL_PIXELFORMAT_ARGB8888);
+
+        if (!surface)
+            return nullptr;
+
+        //Atlas glyphs are white, the color goes in the way SDL_ttf applies it
+        for (int y = 0; y < glyph.h; y++){
+
+            const uint8_t* src = view.pixels + (std::size_t(glyph.y + y)*view.width + glyph.x)*4;
+            Uint32* dst = reinterpret_cast<Uint32*>(static_cast<Uint8*>(surface->pixels) + y*surface->pitch);
+
+            for (int x = 0; x < glyph.w; x++){
+
+                Uint32 alpha = Uint32(src[x*4 + 3]) * color.a / 255;
+
+                dst[x] = (alpha << 24) | (Uint32(color.r) << 16) | (Uint32(color.g) << 8) | Uint32(color.b);
+            }
+        }
+
+        return surface;
+    }
+
+    std::size_t AssetPack::alignOffset(std::size_t offset){
+        return (offset + PINGUI_PACK_ALIGNMENT - 1) & ~std::size_t(PINGUI_PACK_ALIGNMENT - 1);
+    }
+
+#ifdef _WIN32
+
+    bool AssetPack::mapFile(const std::string& filePath){
+
+        HANDLE file = CreateFileA(filePath.c_str(),GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize;
+
+        if (!GetFileSizeEx(file,&fileSize) || fileSize.QuadPart == 0){
+
+            CloseHandle(file);
+            return false;
+        }
+
+        //Copy-on-write, so SDL can never write into the file through a surface
+        HANDLE mapping = CreateFileMappingA(file,nullptr,PAGE_WRITECOPY,0,0,nullptr);
+
+        if (!mapping){
+
+            CloseHandle(file);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping,FILE_MAP_COPY,0,0,0);
+
+        if (!view){
+
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        _fileHandle = file;
+        _mappingHandle = mapping;
+        _data = static_cast<const uint8_t*>(view);
+        _size = std::size_t(fileSize.QuadPart);
+
+        return true;
+    }
+
+    void AssetPack::unmapFile(){
+
+        if (_data)
+            UnmapViewOfFile(_data);
+
+        if (_mappingHandle)
+            CloseHandle(_mappingHandle);
+
+        if (_fileHandle)
+            CloseHandle(_fileHandle);
+
+        _data = nullptr;
+        _size = 0;
+        _mappingHandle = nullptr;
+        _fileHandle = nullptr;
+    }
+
+#else
+
+    bool AssetPack::mapFile(const std::string& filePath){
+
+        int file = ::open(filePath.c_str(),O_RDONLY);
+
+        if (file < 0)
+            return false;
+
+        struct stat fileInfo;
+
+        if (fstat(file,&fileInfo) != 0 || fileInfo.st_size == 0){
+
+            ::close(file);
+            return false;
+        }
+
+        //Private mapping - copy-on-write, so SDL can never write into the file through a surface
+        void* view = mmap(nullptr,std::size_t(fileInfo.st_size),PROT_READ | PROT_WRITE,MAP_PRIVATE,file,0);
+
+        //The mapping stays valid after closing the descriptor
+        ::close(file);
+
+        if (view == MAP_FAILED)
+            return false;
+
+        _data = static_cast<const uint8_t*>(view);
+        _size = std::size_t(fileInfo.st_size);
+
+        return true;
+    }
+
+    void AssetPack::unmapFile(){
+
+        if (_data)
+            munmap(const_cast<uint8_t*>(_data),_size);
+
+        _data = nullptr;
+        _size = 0;
+    }
+
+#endif
+}
@@ -0,0 +1,158 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <mutex>
+
+#include <SDL.h>
+
+/**
+    Prebaked binary pack of the startup assets (made by tools/AssetPacker)
+    The file is memory mapped, surfaces and shader sources are used straight from the mapping
+
+    Layout: packHeader, packEntry table, data blocks aligned to PINGUI_PACK_ALIGNMENT
+    Everything is little endian
+**/
+
+#define PINGUI_ASSET_PACK_PATH "PinGUI/PinGUI.pack"
+
+#define PINGUI_PACK_MAGIC 0x4B504750 // "PGPK"
+
+//Increase when the layout of the pack or of the sheets changes
+#define PINGUI_PACK_VERSION 1
+
+#define PINGUI_PACK_ALIGNMENT 16
+
+namespace PinGUI{
+
+    enum packEntryType{
+        PACK_SURFACE,       //id = surfaceType, RGBA32 pixels
+        PACK_GLYPH_ATLAS,   //id = font size, packGlyphAtlas + packGlyph table + RGBA32 pixels
+        PACK_SHADER,        //id = packShader, source text
+        PACK_FONT           //id = 0 for the default font, TTF file
+    };
+
+    enum packShader{
+        PACK_VERTEX_SHADER,
+        PACK_FRAGMENT_SHADER,
+        PACK_SDF_FRAGMENT_SHADER
+    };
+
+    struct packHeader{
+        uint32_t magic;
+        uint32_t version;
+        uint32_t numOfEntries;
+        uint32_t numOfSurfaces;
+    };
+
+    struct packEntry{
+        uint32_t type;
+        uint32_t id;
+        uint32_t width;
+        uint32_t height;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    struct packGlyphAtlas{
+        uint32_t firstChar;
+        uint32_t numOfGlyphs;
+        int32_t lineHeight;
+        int32_t ascent;
+    };
+
+    struct packGlyph{
+        uint16_t x;
+        uint16_t y;
+        uint16_t w;
+        uint16_t h;
+        int16_t advance;
+        int16_t reserved;
+    };
+
+    //View into the mapped glyph atlas
+    struct glyphAtlasView{
+        const packGlyphAtlas* info;
+        const packGlyph* glyphs;
+        const uint8_t* pixels;
+        int width;
+        int height;
+    };
+
+    class AssetPack{
+
+        private:
+
+            static const uint8_t* _data;
+
+            static std::size_t _size;
+
+            static const packEntry* _ENTRIES;
+
+            static void* _fileHandle;
+
+            static void* _mappingHandle;
+
+            //Pack is shared by all PinGUI contexts, they may open it from different threads
+            static std::mutex _mutex;
+
+            /** Private methods **/
+            static bool mapFile(const std::string& filePath);
+
+            static void unmapFile();
+
+            static bool validate();
+
+        public:
+
+            //Returns false if the pack is missing or doesn't match this version of the library
+            static bool open(const std::string& filePath = PINGUI_ASSET_PACK_PATH);
+
+            //Surfaces and fonts loaded from the pack point into the mapping, close it only after they are gone
+            static void close();
+
+            static bool isOpen();
+
+            static const packEntry* findEntry(packEntryType type, uint32_t id);
+
+            static const uint8_t* getEntryData(const packEntry* entry);
+
+            static uint32_t getNumOfSurfaces();
+
+            static bool getGlyphAtlas(int fontSize, glyphAtlasView& view);
+
+            //Glyph of the default font copied out of the atlas in the color, nullptr when the pack doesn't have it
+            static SDL_Surface* createGlyphSurface(int fontSize, char ch, SDL_Color color);
+
+            static std::size_t alignOffset(std::size_t offset);
+    };
+}
+
+#endif // ASSETPACK_H
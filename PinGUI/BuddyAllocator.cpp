@@ -0,0 +1,180 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "BuddyAllocator.h"
+
+#include <algorithm>
+
+namespace PinGUI{
+
+    BuddyAllocator::BuddyAllocator():
+        _maxOrder(-1),
+        _allocated(0),
+        _requested(0)
+    {
+
+    }
+
+    int BuddyAllocator::orderOf(int size){
+
+        int order = 0;
+
+        while ((1 << order) < size)
+            order++;
+
+        return order;
+    }
+
+    void BuddyAllocator::addFree(int offset, int order){
+
+        while (order < _maxOrder){
+
+            int buddy = offset ^ (1 << order);
+
+            auto it = std::find(_FREE[order].begin(),_FREE[order].end(),buddy);
+
+            if (it == _FREE[order].end())
+                break;
+
+            _FREE[order].erase(it);
+
+            offset = std::min(offset,buddy);
+            order++;
+        }
+
+        _FREE[order].push_back(offset);
+    }
+
+    void BuddyAllocator::reset(int capacity){
+
+        _maxOrder = orderOf(std::max(capacity,1));
+
+        _FREE.assign(_maxOrder + 1,std::vector<int>());
+        _FREE[_maxOrder].push_back(0);
+
+        _BLOCKS.clear();
+        _allocated = 0;
+        _requested = 0;
+    }
+
+    int BuddyAllocator::allocate(int size){
+
+        if (_maxOrder < 0 || size <= 0)
+            return -1;
+
+        int order = orderOf(size);
+
+        //Smallest free block that fits
+        int found = order;
+
+        while (found <= _maxOrder && _FREE[found].empty())
+            found++;
+
+        if (found > _maxOrder)
+            return -1;
+
+        int offset = _FREE[found].back();
+        _FREE[found].pop_back();
+
+        //Splitting it, the upper halves stay free
+        while (found > order){
+
+            found--;
+            _FREE[found].push_back(offset + (1 << found));
+        }
+
+        _BLOCKS[offset] = std::make_pair(order,size);
+        _allocated += 1 << order;
+        _requested += size;
+
+        return offset;
+    }
+
+    bool BuddyAllocator::release(int offset){
+
+        auto it = _BLOCKS.find(offset);
+
+        if (it == _BLOCKS.end())
+            return false;
+
+        int order = it->second.first;
+
+        _allocated -= 1 << order;
+        _requested -= it->second.second;
+
+        _BLOCKS.erase(it);
+
+        addFree(offset,order);
+
+        return true;
+    }
+
+    void BuddyAllocator::grow(){
+
+        if (_maxOrder < 0){
+
+            reset(1);
+            return;
+        }
+
+        //The old space is the lower half now, the upper half is one free block
+        int oldOrder = _maxOrder;
+
+        _maxOrder++;
+        _FREE.resize(_maxOrder + 1);
+
+        addFree(1 << oldOrder,oldOrder);
+    }
+
+    int BuddyAllocator::getBlockSize(int offset) const{
+
+        auto it = _BLOCKS.find(offset);
+
+        return (it == _BLOCKS.end()) ? 0 : (1 << it->second.first);
+    }
+
+    int BuddyAllocator::getCapacity() const{
+        return (_maxOrder < 0) ? 0 : (1 << _maxOrder);
+    }
+
+    allocatorStats BuddyAllocator::getStats() const{
+
+        allocatorStats stats;
+
+        stats.capacity = getCapacity();
+        stats.allocated = _allocated;
+        stats.requested = _requested;
+
+        for (std::size_t i = 0; i < _FREE.size(); i++){
+
+            stats.freeBlocks += int(_FREE[i].size());
+
+            if (!_FREE[i].empty())
+                stats.largestFree = 1 << int(i);
+        }
+
+        return stats;
+    }
+}
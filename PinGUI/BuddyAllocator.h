@@ -0,0 +1,102 @@
+#ifndef BUDDYALLOCATOR_H
+#define BUDDYALLOCATOR_H
+
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include <vector>
+#include <map>
+
+namespace PinGUI{
+
+    //Usage of a BuddyAllocator, in its units
+    struct allocatorStats{
+
+        int capacity = 0;
+
+        //Units in the handed out blocks
+        int allocated = 0;
+
+        //Units that were asked for, the rest of allocated is lost to rounding up
+        int requested = 0;
+
+        int freeBlocks = 0;
+
+        //Biggest block that can be handed out without growing
+        int largestFree = 0;
+    };
+
+    /**
+        Hands out ranges of a power of two sized space as power of two blocks
+        Freed blocks merge back with their free buddies, so the space doesn't split into small pieces
+    **/
+    class BuddyAllocator
+    {
+        private:
+
+            //Capacity is 1 << _maxOrder, -1 before reset
+            int _maxOrder;
+
+            //Offsets of free blocks for every order
+            std::vector<std::vector<int>> _FREE;
+
+            //Offset of a handed out block - its order and the requested size
+            std::map<int,std::pair<int,int>> _BLOCKS;
+
+            int _allocated;
+
+            int _requested;
+
+            /** Private methods **/
+            static int orderOf(int size);
+
+            //Merges the block with its free buddies first
+            void addFree(int offset, int order);
+
+        public:
+
+            BuddyAllocator();
+
+            //Forgets all blocks, capacity is rounded up to a power of two
+            void reset(int capacity);
+
+            //Offset of the block, -1 when there is no free block big enough
+            int allocate(int size);
+
+            //False for offsets that weren't handed out
+            bool release(int offset);
+
+            //Doubles the capacity, the blocks stay where they are
+            void grow();
+
+            int getBlockSize(int offset) const;
+
+            int getCapacity() const;
+
+            allocatorStats getStats() const;
+    };
+}
+
+#endif // BUDDYALLOCATOR_H
@@ -26,13 +26,21 @@
 
 namespace PinGUI{
 
-    GLint CameraManager::_matricesLocations[1];
+    thread_local GLint CameraManager::_matricesLocations[1];
 
-    glm::mat4 CameraManager::_staticCameraMatrix;
+    thread_local glm::mat4 CameraManager::_staticCameraMatrix;
 
-    int CameraManager::_screenWidth;
+    thread_local int CameraManager::_screenWidth;
 
-    int CameraManager::_screenHeight;
+    thread_local int CameraManager::_screenHeight;
+
+    void CameraManager::swapContext(contextState& state){
+
+        std::swap(_matricesLocations,state.matricesLocations);
+        std::swap(_staticCameraMatrix,state.cameraMatrix);
+        std::swap(_screenWidth,state.screenWidth);
+        std::swap(_screenHeight,state.screenHeight);
+    }
 
     void CameraManager::init(int screenWidth, int screenHeight){
 
@@ -50,6 +58,14 @@ namespace PinGUI{
         return _staticCameraMatrix;
     }
 
+    int CameraManager::getScreenWidth(){
+        return _screenWidth;
+    }
+
+    int CameraManager::getScreenHeight(){
+        return _screenHeight;
+    }
+
     void CameraManager::setMatrixLocation(cameraType type, GLint location){
 
         _matricesLocations[type] = location;
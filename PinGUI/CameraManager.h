@@ -43,21 +43,35 @@ namespace PinGUI{
     {
         private:
 
-            static GLint _matricesLocations[1];
+            static thread_local GLint _matricesLocations[1];
 
-            static glm::mat4 _staticCameraMatrix;
+            static thread_local glm::mat4 _staticCameraMatrix;
 
-            static int _screenWidth;
+            static thread_local int _screenWidth;
 
-            static int _screenHeight;
+            static thread_local int _screenHeight;
 
         public:
 
+            //Camera of one PinGUI::Context
+            struct contextState{
+                GLint matricesLocations[1] = {0};
+                glm::mat4 cameraMatrix = glm::mat4(1.0f);
+                int screenWidth = 0;
+                int screenHeight = 0;
+            };
+
+            static void swapContext(contextState& state);
+
             //sets up the orthographic matrix and screen dimensions
             static void init(int screenWidth, int screenHeight);
 
             static glm::mat4 getCameraMatrix();
 
+            static int getScreenWidth();
+
+            static int getScreenHeight();
+
             static void setMatrixLocation(cameraType type, GLint location);
 
             static GLint getMatrixLocation(cameraType type);
@@ -0,0 +1,104 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "Context.h"
+
+namespace PinGUI{
+
+    thread_local Context* Context::_current = nullptr;
+
+    Context::Context():
+        _library(new PINGUI::contextState()),
+        _input(new Input_Manager::contextState()),
+        _cursor(new GUI_Cursor::contextState()),
+        _crop(new CropManager::contextState()),
+        _sheets(new SheetManager::contextState()),
+        _camera(new CameraManager::contextState()),
+        _shaders(new Shader_Program::contextState()),
+        _glState(new GL_StateManager::contextState()),
+        _colors(new GUI_ColorManager::contextState()),
+        _damage(new DamageTracker::contextState()),
+        _indices(new VBO_Manager::contextState())
+    {
+
+    }
+
+    Context::~Context()
+    {
+        Context* previous = (_current != this) ? _current : nullptr;
+
+        makeCurrent();
+
+        PINGUI::destroy();
+
+        release();
+
+        if (previous)
+            previous->makeCurrent();
+    }
+
+    void Context::swapState(){
+
+        PINGUI::swapContext(*_library);
+        Input_Manager::swapContext(*_input);
+        GUI_Cursor::swapContext(*_cursor);
+        CropManager::swapContext(*_crop);
+        SheetManager::swapContext(*_sheets);
+        CameraManager::swapContext(*_camera);
+        Shader_Program::swapContext(*_shaders);
+        GL_StateManager::swapContext(*_glState);
+        GUI_ColorManager::swapContext(*_colors);
+        DamageTracker::swapContext(*_damage);
+        VBO_Manager::swapContext(*_indices);
+    }
+
+    void Context::makeCurrent(){
+
+        if (_current == this)
+            return;
+
+        release();
+
+        swapState();
+        _current = this;
+    }
+
+    bool Context::isCurrent(){
+        return _current == this;
+    }
+
+    void Context::release(){
+
+        if (!_current)
+            return;
+
+        _current->swapState();
+        _current = nullptr;
+    }
+
+    Context* Context::getCurrent(){
+        return _current;
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef CONTEXT_H
+#define CONTEXT_H
+
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include <memory>
+
+#include "PINGUI.h"
+
+namespace PinGUI{
+
+    /**
+        Owns the whole state of one GUI - windows, input, cursor, cropping, sheets, camera, shaders, GL cache, damage and shared GPU buffers
+
+        The static API always works with the context that is current on the calling thread.
+        Without any current context it works with the thread's own default state, so applications
+        with a single GUI don't need to create contexts at all
+
+        Contexts on different threads run independently. Contexts sharing one thread are switched
+        with makeCurrent, the application switches their GL contexts (SDL_GL_MakeCurrent) along with them
+    **/
+    class Context
+    {
+        private:
+
+            static thread_local Context* _current;
+
+            std::unique_ptr<PINGUI::contextState> _library;
+
+            std::unique_ptr<Input_Manager::contextState> _input;
+
+            std::unique_ptr<GUI_Cursor::contextState> _cursor;
+
+            std::unique_ptr<CropManager::contextState> _crop;
+
+            std::unique_ptr<SheetManager::contextState> _sheets;
+
+            std::unique_ptr<CameraManager::contextState> _camera;
+
+            std::unique_ptr<Shader_Program::contextState> _shaders;
+
+            std::unique_ptr<GL_StateManager::contextState> _glState;
+
+            std::unique_ptr<GUI_ColorManager::contextState> _colors;
+
+            std::unique_ptr<DamageTracker::contextState> _damage;
+
+            std::unique_ptr<VBO_Manager::contextState> _indices;
+
+            /** Private methods **/
+
+            //Exchanges the thread's statics with the stored state
+            void swapState();
+
+        public:
+
+            Context();
+
+            //Destroys the GUI of the context - has to run on its thread with its GL context current
+            ~Context();
+
+            Context(const Context&) = delete;
+
+            Context& operator=(const Context&) = delete;
+
+            //The previous context of this thread is stored back first
+            void makeCurrent();
+
+            bool isCurrent();
+
+            //Stores the current context, the thread gets back its default state
+            static void release();
+
+            static Context* getCurrent();
+    };
+}
+
+#endif // CONTEXT_H
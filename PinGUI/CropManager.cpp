@@ -24,11 +24,18 @@
 
 #include "CropManager.hpp"
 
-int CropManager::_cropVar = 0;
+thread_local int CropManager::_cropVar = 0;
 
-int CropManager::_cropSize = 0;
+thread_local int CropManager::_cropSize = 0;
 
-PinGUI::Rect CropManager::_lastCropRect(0,0,0,0);
+thread_local PinGUI::Rect CropManager::_lastCropRect(0,0,0,0);
+
+void CropManager::swapContext(contextState& state){
+
+    std::swap(_cropVar,state.cropVar);
+    std::swap(_cropSize,state.cropSize);
+    std::swap(_lastCropRect,state.lastCropRect);
+}
 
 inline bool collideFromLeft(PinGUI::Rect& cropRect, PinGUI::Rect& dstRect){
 
@@ -255,6 +262,9 @@ void CropManager::cropSpriteHorizontally(GUI_Sprite*& sprite, PinGUI::Rect& crop
 
         percentage.x = static_cast<float>(_cropVar) / static_cast<float>(rect.realRect.w);
 
+        //Editable texts show only a part of their texture
+        percentage.x = sprite->getU(percentage.x);
+
         changeUV(LEFT, sprite->getVBOData(), percentage);
 
         sprite->getGUIRect_P()->rect.x = cropRect.x ;
@@ -280,6 +290,8 @@ void CropManager::cropSpriteHorizontally(GUI_Sprite*& sprite, PinGUI::Rect& crop
 
         percentage.x = 1.0f - (static_cast<float>(_cropVar) / static_cast<float>(rect.realRect.w));
 
+        percentage.x = sprite->getU(percentage.x);
+
         changeUV(RIGHT, sprite->getVBOData(), percentage);
 
         cropSize -= _cropVar;
@@ -289,7 +301,7 @@ void CropManager::cropSpriteHorizontally(GUI_Sprite*& sprite, PinGUI::Rect& crop
     } else if (sprite->getGUIRect().rect.w != rect.realRect.w){
 
         sprite->setW(rect.realRect.w);
-        percentage.x = 1.0f;
+        percentage.x = sprite->getU(1.0f);
         changeUV(RIGHT, sprite->getVBOData(), percentage);
         sprite->updatePositions();
     }
@@ -306,10 +318,10 @@ void CropManager::cropSpriteHorizontally(GUI_Sprite*& sprite, PinGUI::Rect& crop
 void CropManager::changeUV(orientation orient, vboData* dataPointer, PinGUI::Vector2<float> percentage){
 
     /**
+        0 - Top right
         1 - Top left
-        2,3 - Bottom Left
-        4 - Bottom right
-        0,5 - Top right
+        2 - Bottom left
+        3 - Bottom right
 
     **/
 
@@ -319,7 +331,6 @@ void CropManager::changeUV(orientation orient, vboData* dataPointer, PinGUI::Vec
 
             dataPointer->vertices[1].setU(percentage.x);
             dataPointer->vertices[2].setU(percentage.x);
-            dataPointer->vertices[3].setU(percentage.x);
 
             break;
         }
@@ -327,8 +338,7 @@ void CropManager::changeUV(orientation orient, vboData* dataPointer, PinGUI::Vec
         case RIGHT : {
 
             dataPointer->vertices[0].setU(percentage.x);
-            dataPointer->vertices[4].setU(percentage.x);
-            dataPointer->vertices[5].setU(percentage.x);
+            dataPointer->vertices[3].setU(percentage.x);
 
             break;
         }
@@ -337,7 +347,6 @@ void CropManager::changeUV(orientation orient, vboData* dataPointer, PinGUI::Vec
 
             dataPointer->vertices[0].setV(percentage.x);
             dataPointer->vertices[1].setV(percentage.x);
-            dataPointer->vertices[5].setV(percentage.x);
 
             break;
         }
@@ -346,7 +355,6 @@ void CropManager::changeUV(orientation orient, vboData* dataPointer, PinGUI::Vec
 
             dataPointer->vertices[2].setV(percentage.x);
             dataPointer->vertices[3].setV(percentage.x);
-            dataPointer->vertices[4].setV(percentage.x);
 
             break;
         }
@@ -47,11 +47,11 @@ class CropManager{
 
     private :
 
-        static int _cropVar;
+        static thread_local int _cropVar;
 
-        static int _cropSize;
+        static thread_local int _cropSize;
 
-        static PinGUI::Rect _lastCropRect;
+        static thread_local PinGUI::Rect _lastCropRect;
 
 
         /**
@@ -81,6 +81,15 @@ class CropManager{
 
     public :
 
+        //Cropping state of one PinGUI::Context
+        struct contextState{
+            int cropVar = 0;
+            int cropSize = 0;
+            PinGUI::Rect lastCropRect = PinGUI::Rect(0,0,0,0);
+        };
+
+        static void swapContext(contextState& state);
+
         //Cropping GUIRectangles
         static void cropRect(PinGUI::Rect cropRect, GUIRect& dstRect);
 
@@ -0,0 +1,199 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "DamageTracker.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+namespace PinGUI{
+
+    thread_local bool DamageTracker::_enabled = false;
+
+    thread_local bool DamageTracker::_fullDamage = false;
+
+    thread_local std::vector<PinGUI::Rect> DamageTracker::_RECTS;
+
+    void DamageTracker::swapContext(contextState& state){
+
+        std::swap(_enabled,state.enabled);
+        std::swap(_fullDamage,state.fullDamage);
+        std::swap(_RECTS,state.rects);
+    }
+
+    void DamageTracker::setEnabled(bool state){
+
+        _enabled = state;
+        clear();
+    }
+
+    bool DamageTracker::isEnabled(){
+        return _enabled;
+    }
+
+    inline bool touches(const PinGUI::Rect& a, const PinGUI::Rect& b){
+
+        return a.x <= b.x + b.w && b.x <= a.x + a.w &&
+               a.y <= b.y + b.h && b.y <= a.y + a.h;
+    }
+
+    inline PinGUI::Rect unite(const PinGUI::Rect& a, const PinGUI::Rect& b){
+
+        float left = std::min(a.x,b.x);
+        float bottom = std::min(a.y,b.y);
+        float right = std::max(a.x + a.w,b.x + b.w);
+        float top = std::max(a.y + a.h,b.y + b.h);
+
+        return PinGUI::Rect(left,bottom,int(right - left),int(top - bottom));
+    }
+
+    void DamageTracker::mergeRect(PinGUI::Rect rect){
+
+        //Overlapping rectangles would be drawn twice, so they are joined
+        for (std::size_t i = 0; i < _RECTS.size(); i++){
+
+            if (touches(_RECTS[i],rect)){
+
+                rect = unite(_RECTS[i],rect);
+
+                _RECTS[i] = _RECTS.back();
+                _RECTS.pop_back();
+                i = std::size_t(-1);
+            }
+        }
+
+        _RECTS.push_back(rect);
+
+        if (_RECTS.size() > PINGUI_DAMAGE_RECTS_LIMIT){
+
+            PinGUI::Rect bounds;
+            getBounds(bounds);
+
+            _RECTS.clear();
+            _RECTS.push_back(bounds);
+        }
+    }
+
+    void DamageTracker::addRect(const PinGUI::Rect& rect){
+
+        if (!_enabled || _fullDamage || rect.w <= 0 || rect.h <= 0)
+            return;
+
+        mergeRect(rect);
+    }
+
+    void DamageTracker::addQuad(const vboData& quad){
+
+        if (!_enabled || _fullDamage)
+            return;
+
+        float left = quad.vertices[0].position.x, right = left;
+        float bottom = quad.vertices[0].position.y, top = bottom;
+
+        for (int i = 1; i < PINGUI_QUAD_VERTICES; i++){
+
+            left = std::min(left,quad.vertices[i].position.x);
+            right = std::max(right,quad.vertices[i].position.x);
+            bottom = std::min(bottom,quad.vertices[i].position.y);
+            top = std::max(top,quad.vertices[i].position.y);
+        }
+
+        //Cropped away quad
+        if (right <= left || top <= bottom)
+            return;
+
+        left = std::floor(left) - PINGUI_DAMAGE_PADDING;
+        bottom = std::floor(bottom) - PINGUI_DAMAGE_PADDING;
+        right = std::ceil(right) + PINGUI_DAMAGE_PADDING;
+        top = std::ceil(top) + PINGUI_DAMAGE_PADDING;
+
+        mergeRect(PinGUI::Rect(left,bottom,int(right - left),int(top - bottom)));
+    }
+
+    void DamageTracker::addChanges(const std::vector<vboData>& previous, const std::vector<vboData>& current){
+
+        if (!_enabled || _fullDamage)
+            return;
+
+        std::size_t common = std::min(previous.size(),current.size());
+
+        for (std::size_t i = 0; i < common; i++){
+
+            if (std::memcmp(&previous[i],&current[i],sizeof(vboData)) != 0){
+
+                addQuad(previous[i]);
+                addQuad(current[i]);
+            }
+        }
+
+        //Removed or added quads
+        for (std::size_t i = common; i < previous.size(); i++)
+            addQuad(previous[i]);
+
+        for (std::size_t i = common; i < current.size(); i++)
+            addQuad(current[i]);
+    }
+
+    void DamageTracker::addFullDamage(){
+
+        if (!_enabled)
+            return;
+
+        _fullDamage = true;
+        _RECTS.clear();
+    }
+
+    bool DamageTracker::isFullDamage(){
+        return _fullDamage;
+    }
+
+    bool DamageTracker::isEmpty(){
+        return !_fullDamage && _RECTS.empty();
+    }
+
+    const std::vector<PinGUI::Rect>& DamageTracker::getRects(){
+        return _RECTS;
+    }
+
+    bool DamageTracker::getBounds(PinGUI::Rect& bounds){
+
+        if (_RECTS.empty())
+            return false;
+
+        bounds = _RECTS[0];
+
+        for (std::size_t i = 1; i < _RECTS.size(); i++)
+            bounds = unite(bounds,_RECTS[i]);
+
+        return true;
+    }
+
+    void DamageTracker::clear(){
+
+        _fullDamage = false;
+        _RECTS.clear();
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef DAMAGETRACKER_H
+#define DAMAGETRACKER_H
+
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include <vector>
+
+#include "stuff.h"
+#include "PinGUI_Rect.hpp"
+
+//Above this number the rectangles are merged into one
+#define PINGUI_DAMAGE_RECTS_LIMIT 8
+
+//Extra pixels around every damaged quad
+#define PINGUI_DAMAGE_PADDING 1
+
+//Damaged rects are redrawn as one rect while their bounds are at most this times bigger than they are
+#define PINGUI_DAMAGE_MERGE_RATIO 2.0f
+
+namespace PinGUI{
+
+    /**
+        Screen rectangles that changed since the GUI layer was redrawn
+        Collected only while enabled - PINGUI enables it with the layer cache
+    **/
+    class DamageTracker
+    {
+        private:
+
+            static thread_local bool _enabled;
+
+            static thread_local bool _fullDamage;
+
+            static thread_local std::vector<PinGUI::Rect> _RECTS;
+
+            /** Private methods **/
+            static void mergeRect(PinGUI::Rect rect);
+
+        public:
+
+            //Damage of one PinGUI::Context
+            struct contextState{
+                bool enabled = false;
+                bool fullDamage = false;
+                std::vector<PinGUI::Rect> rects;
+            };
+
+            static void swapContext(contextState& state);
+
+            static void setEnabled(bool state);
+
+            static bool isEnabled();
+
+            static void addRect(const PinGUI::Rect& rect);
+
+            static void addQuad(const vboData& quad);
+
+            //Damages the quads which differ between the previously uploaded and the new data
+            static void addChanges(const std::vector<vboData>& previous, const std::vector<vboData>& current);
+
+            static void addFullDamage();
+
+            static bool isFullDamage();
+
+            static bool isEmpty();
+
+            static const std::vector<PinGUI::Rect>& getRects();
+
+            //Rectangle around all damaged rectangles, false when there are none
+            static bool getBounds(PinGUI::Rect& bounds);
+
+            static void clear();
+    };
+}
+
+#endif // DAMAGETRACKER_H
@@ -0,0 +1,245 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "GL_StateManager.h"
+
+namespace PinGUI{
+
+    thread_local GLuint GL_StateManager::_program = 0;
+
+    thread_local GLuint GL_StateManager::_vertexArray = 0;
+
+    thread_local GLuint GL_StateManager::_arrayBuffer = 0;
+
+    thread_local GLenum GL_StateManager::_activeTexture = GL_TEXTURE0;
+
+    thread_local GLuint GL_StateManager::_TEXTURES[PINGUI_GL_TEXTURE_UNITS] = {0};
+
+    thread_local std::unordered_map<GLuint,uint32_t> GL_StateManager::_ATTRIBUTES;
+
+    thread_local std::unordered_map<uint64_t,GLint> GL_StateManager::_INT_UNIFORMS;
+
+    thread_local std::unordered_map<uint64_t,glm::mat4> GL_StateManager::_MATRIX_UNIFORMS;
+
+    thread_local uint64_t GL_StateManager::_issuedCalls = 0;
+
+    thread_local uint64_t GL_StateManager::_elidedCalls = 0;
+
+    void GL_StateManager::swapContext(contextState& state){
+
+        std::swap(_program,state.program);
+        std::swap(_vertexArray,state.vertexArray);
+        std::swap(_arrayBuffer,state.arrayBuffer);
+        std::swap(_activeTexture,state.activeTexture);
+        std::swap(_TEXTURES,state.textures);
+        std::swap(_ATTRIBUTES,state.attributes);
+        std::swap(_INT_UNIFORMS,state.intUniforms);
+        std::swap(_MATRIX_UNIFORMS,state.matrixUniforms);
+        std::swap(_issuedCalls,state.issuedCalls);
+        std::swap(_elidedCalls,state.elidedCalls);
+    }
+
+    bool GL_StateManager::checkState(bool changed){
+
+        if (changed)
+            _issuedCalls++;
+        else
+            _elidedCalls++;
+
+        return changed;
+    }
+
+    uint64_t GL_StateManager::getUniformKey(GLint location){
+        return (uint64_t(_program) << 32) | uint32_t(location);
+    }
+
+    std::size_t GL_StateManager::getTextureUnit(){
+        return std::size_t(_activeTexture - GL_TEXTURE0);
+    }
+
+    void GL_StateManager::invalidate(){
+
+        //Real values are unknown, -1 is never a valid name so the next binds always go through
+        _program = GLuint(-1);
+        _vertexArray = GLuint(-1);
+        _arrayBuffer = GLuint(-1);
+        _activeTexture = GL_TEXTURE0;
+
+        for (std::size_t i = 0; i < PINGUI_GL_TEXTURE_UNITS; i++)
+            _TEXTURES[i] = GLuint(-1);
+
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    void GL_StateManager::useProgram(GLuint program){
+
+        if (checkState(_program != program)){
+
+            _program = program;
+            glUseProgram(program);
+        }
+    }
+
+    void GL_StateManager::bindVertexArray(GLuint vertexArray){
+
+        if (checkState(_vertexArray != vertexArray)){
+
+            _vertexArray = vertexArray;
+            glBindVertexArray(vertexArray);
+        }
+    }
+
+    GLuint GL_StateManager::getVertexArray(){
+        return _vertexArray;
+    }
+
+    void GL_StateManager::bindArrayBuffer(GLuint buffer){
+
+        if (checkState(_arrayBuffer != buffer)){
+
+            _arrayBuffer = buffer;
+            glBindBuffer(GL_ARRAY_BUFFER,buffer);
+        }
+    }
+
+    void GL_StateManager::activeTexture(GLenum unit){
+
+        if (checkState(_activeTexture != unit)){
+
+            _activeTexture = unit;
+            glActiveTexture(unit);
+        }
+    }
+
+    void GL_StateManager::bindTexture(GLuint texture){
+
+        GLuint& bound = _TEXTURES[getTextureUnit()];
+
+        if (checkState(bound != texture)){
+
+            bound = texture;
+            glBindTexture(GL_TEXTURE_2D,texture);
+        }
+    }
+
+    void GL_StateManager::enableAttribute(GLuint index){
+
+        uint32_t& mask = _ATTRIBUTES[_vertexArray];
+
+        if (checkState(!(mask & (1u << index)))){
+
+            mask |= (1u << index);
+            glEnableVertexAttribArray(index);
+        }
+    }
+
+    void GL_StateManager::disableAttribute(GLuint index){
+
+        uint32_t& mask = _ATTRIBUTES[_vertexArray];
+
+        if (checkState((mask & (1u << index)) != 0)){
+
+            mask &= ~(1u << index);
+            glDisableVertexAttribArray(index);
+        }
+    }
+
+    void GL_StateManager::setUniform(GLint location, GLint value){
+
+        auto it = _INT_UNIFORMS.find(getUniformKey(location));
+
+        if (checkState(it == _INT_UNIFORMS.end() || it->second != value)){
+
+            _INT_UNIFORMS[getUniformKey(location)] = value;
+            glUniform1i(location,value);
+        }
+    }
+
+    void GL_StateManager::setUniform(GLint location, const glm::mat4& value){
+
+        auto it = _MATRIX_UNIFORMS.find(getUniformKey(location));
+
+        if (checkState(it == _MATRIX_UNIFORMS.end() || it->second != value)){
+
+            _MATRIX_UNIFORMS[getUniformKey(location)] = value;
+            glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+        }
+    }
+
+    void GL_StateManager::deleteTexture(GLuint& texture){
+
+        if (texture == 0)
+            return;
+
+        for (std::size_t i = 0; i < PINGUI_GL_TEXTURE_UNITS; i++){
+
+            if (_TEXTURES[i] == texture)
+                _TEXTURES[i] = 0;
+        }
+
+        glDeleteTextures(1,&texture);
+        texture = 0;
+    }
+
+    void GL_StateManager::deleteBuffer(GLuint& buffer){
+
+        if (buffer == 0)
+            return;
+
+        if (_arrayBuffer == buffer)
+            _arrayBuffer = 0;
+
+        glDeleteBuffers(1,&buffer);
+        buffer = 0;
+    }
+
+    void GL_StateManager::deleteVertexArray(GLuint& vertexArray){
+
+        if (vertexArray == 0)
+            return;
+
+        if (_vertexArray == vertexArray)
+            _vertexArray = 0;
+
+        _ATTRIBUTES.erase(vertexArray);
+
+        glDeleteVertexArrays(1,&vertexArray);
+        vertexArray = 0;
+    }
+
+    uint64_t GL_StateManager::getIssuedCalls(){
+        return _issuedCalls;
+    }
+
+    uint64_t GL_StateManager::getElidedCalls(){
+        return _elidedCalls;
+    }
+
+    void GL_StateManager::resetCounters(){
+
+        _issuedCalls = 0;
+        _elidedCalls = 0;
+    }
+}
@@ -0,0 +1,135 @@
+#ifndef GL_STATEMANAGER_H
+#define GL_STATEMANAGER_H
+
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <unordered_map>
+#include <cstdint>
+
+#define PINGUI_GL_TEXTURE_UNITS 8
+
+namespace PinGUI{
+
+    /**
+        All GL binds of PinGUI go through here, so the ones that wouldn't change
+        anything are never sent to the driver
+    **/
+    class GL_StateManager
+    {
+        private:
+
+            static thread_local GLuint _program;
+
+            static thread_local GLuint _vertexArray;
+
+            static thread_local GLuint _arrayBuffer;
+
+            static thread_local GLenum _activeTexture;
+
+            static thread_local GLuint _TEXTURES[PINGUI_GL_TEXTURE_UNITS];
+
+            //Enabled attributes are a state of the bound VAO
+            static thread_local std::unordered_map<GLuint,uint32_t> _ATTRIBUTES;
+
+            //Uniforms are a state of the program, key is program and location
+            static thread_local std::unordered_map<uint64_t,GLint> _INT_UNIFORMS;
+
+            static thread_local std::unordered_map<uint64_t,glm::mat4> _MATRIX_UNIFORMS;
+
+            static thread_local uint64_t _issuedCalls;
+
+            static thread_local uint64_t _elidedCalls;
+
+            /**
+                Private methods
+            **/
+            static bool checkState(bool changed);
+
+            static uint64_t getUniformKey(GLint location);
+
+            static std::size_t getTextureUnit();
+
+        public:
+
+            //Cache of one PinGUI::Context - it mirrors the GL context the PinGUI::Context renders with
+            struct contextState{
+                GLuint program = 0;
+                GLuint vertexArray = 0;
+                GLuint arrayBuffer = 0;
+                GLenum activeTexture = GL_TEXTURE0;
+                GLuint textures[PINGUI_GL_TEXTURE_UNITS] = {0};
+                std::unordered_map<GLuint,uint32_t> attributes;
+                std::unordered_map<uint64_t,GLint> intUniforms;
+                std::unordered_map<uint64_t,glm::mat4> matrixUniforms;
+                uint64_t issuedCalls = 0;
+                uint64_t elidedCalls = 0;
+            };
+
+            static void swapContext(contextState& state);
+
+            //Forgets the bindings, call it when GL was touched outside of PinGUI
+            static void invalidate();
+
+            static void useProgram(GLuint program);
+
+            static void bindVertexArray(GLuint vertexArray);
+
+            //Cached binding, elements with their own VAO restore it after drawing
+            static GLuint getVertexArray();
+
+            static void bindArrayBuffer(GLuint buffer);
+
+            static void activeTexture(GLenum unit);
+
+            static void bindTexture(GLuint texture);
+
+            static void enableAttribute(GLuint index);
+
+            static void disableAttribute(GLuint index);
+
+            static void setUniform(GLint location, GLint value);
+
+            static void setUniform(GLint location, const glm::mat4& value);
+
+            //Deleted objects are unbound by GL, so the cache has to know about them
+            static void deleteTexture(GLuint& texture);
+
+            static void deleteBuffer(GLuint& buffer);
+
+            static void deleteVertexArray(GLuint& vertexArray);
+
+            static uint64_t getIssuedCalls();
+
+            static uint64_t getElidedCalls();
+
+            static void resetCounters();
+    };
+}
+
+#endif // GL_STATEMANAGER_H
@@ -24,6 +24,9 @@
 
 #include "GL_Vertex.h"
 
+#include <cmath>
+#include <algorithm>
+
 namespace PinGUI{
     VertexColor::VertexColor(){
 
@@ -73,4 +76,15 @@ namespace PinGUI{
         uv.v = V;
     }
 
+    void CompactVertex::pack(const Vertex& vertex){
+
+        x = GLshort(std::max(-32768.0f,std::min(32767.0f,std::round(vertex.position.x))));
+        y = GLshort(std::max(-32768.0f,std::min(32767.0f,std::round(vertex.position.y))));
+
+        color = vertex.color;
+
+        u = GLushort(std::round(std::max(0.0f,std::min(1.0f,vertex.uv.u)) * 65535.0f));
+        v = GLushort(std::round(std::max(0.0f,std::min(1.0f,vertex.uv.v)) * 65535.0f));
+    }
+
 }
@@ -27,6 +27,11 @@
 
 #include <GL/glew.h>
 
+/**
+    Vertices are built as floats, VBO_Manager uploads them in one of two formats:
+    by default as they are (20 bytes), with PINGUI_COMPACT_VERTICES defined as CompactVertex (12 bytes)
+**/
+
 namespace PinGUI{
 
     class VertexColor{
@@ -98,6 +103,27 @@ namespace PinGUI{
             void setV(float V);
     };
 
+    /**
+        Quantized vertex - position in whole pixels from -32768 to 32767, UV in 1/65535 steps.
+        Fractional positions are rounded, so it fits GUIs without subpixel movement
+    **/
+    class CompactVertex{
+        public:
+            GLshort x;
+            GLshort y;
+            VertexColor color;
+            GLushort u;
+            GLushort v;
+
+            void pack(const Vertex& vertex);
+    };
+
+#ifdef PINGUI_COMPACT_VERTICES
+    typedef CompactVertex BufferVertex;
+#else
+    typedef Vertex BufferVertex;
+#endif
+
 }
 
 #endif // GL_VERTEX_H
@@ -24,31 +24,44 @@
 
 #include "GUIManager.h"
 
+#include <cfloat>
+#include <cmath>
+
 #include "GUI_Elements\WindowButton.h"
 #include "GUI_Elements\IconButton.h"
 
 GUIManager::GUIManager():
-    _needUpdate(false),
-    _manipulatingMod(false),
+    _pendingElements(0),
+    _alpha(255),
+    _storeChanged(false),
     _manipulatingElement(nullptr),
     _collidingElement(nullptr),
-    _moved(false)
+    _needUpdate(false),
+    _moved(false),
+    _vboPrepared(false),
+    _revision(0),
+    _manipulatingMod(false)
 {
-    _vboMANAGER = std::make_unique<VBO_Manager>(100,true);
+    _vboMANAGER = std::make_unique<VBO_Manager>(100,true,true);
 	 
     _texter = std::make_shared<TextManager>();
 }
 
 GUIManager::GUIManager(std::shared_ptr<TextManager> texter):
-    _needUpdate(false),
-    _manipulatingMod(false),
+    _pendingElements(0),
+    _alpha(255),
+    _storeChanged(false),
     _manipulatingElement(nullptr),
     _collidingElement(nullptr),
-    _moved(false)
+    _needUpdate(false),
+    _moved(false),
+    _vboPrepared(false),
+    _revision(0),
+    _manipulatingMod(false)
 {
     this->_texter = texter;
 
-    _vboMANAGER = std::make_unique<VBO_Manager>(100,true);
+    _vboMANAGER = std::make_unique<VBO_Manager>(100,true,true);
 }
 
 GUIManager::~GUIManager()
@@ -128,6 +141,17 @@ void GUIManager::createComboBox(GUIPos x, GUIPos y, std::vector<std::string> ite
     _needUpdate = true;
 }
 
+void GUIManager::createVirtualComboBox(GUIPos x, GUIPos y, std::vector<std::string> items, int maxSize, int maxNumOfItems){
+
+	clipboardData tmp(getTextManager());
+
+    auto ptr = std::make_shared<ComboBox>(x,y,std::move(items),tmp,&_ELEMENTS, maxNumOfItems,&_needUpdate,maxSize,true);
+
+    _ELEMENTS.push_back(ptr);
+
+    _needUpdate = true;
+}
+
 void GUIManager::createVolumeBoard(GUIPos x, GUIPos y, bool clickable, int* var, int maxSize){
 
     //Block for creating a clipboard
@@ -249,6 +273,26 @@ void GUIManager::createImage(SDL_Surface* imageSurface, GUIPos x, GUIPos y, int
     _needUpdate = true;
 }
 
+std::shared_ptr<StreamingImage> GUIManager::createStreamingImage(GUIPos x, GUIPos y, int width, int height, GLenum format){
+
+    auto ptr = std::make_shared<StreamingImage>(x,y,width,height,format);
+    _ELEMENTS.push_back(ptr);
+
+    _needUpdate = true;
+
+    return ptr;
+}
+
+std::shared_ptr<TiledImage> GUIManager::createTiledImage(SDL_Surface* imageSurface, GUIPos x, GUIPos y, int width, int height){
+
+    auto ptr = std::make_shared<TiledImage>(imageSurface,x,y,width,height);
+    _ELEMENTS.push_back(ptr);
+
+    _needUpdate = true;
+
+    return ptr;
+}
+
 void GUIManager::createButton(GUIPos x, GUIPos y, std::string name, PinGUI::basicPointer f){
 
 	clipboardData tmp(getTextManager());
@@ -314,6 +358,31 @@ void GUIManager::createCheckBox(GUIPos x, GUIPos y, bool* var){
     _needUpdate = true;
 }
 
+std::shared_ptr<Table> GUIManager::createTable(GUIPos x, GUIPos y, std::vector<int> columnWidths, std::size_t rowCount, unsigned int visibleRows, PinGUI::tableFuncPointer cellFunction){
+
+	clipboardData tmp(getTextManager());
+
+    auto ptr = std::make_shared<Table>(x,y,std::move(columnWidths),rowCount,visibleRows,cellFunction,tmp,&_ELEMENTS,&_needUpdate);
+
+    //Cells and scroller are already in, the table goes after them so they are drawn first and hit first
+    _ELEMENTS.push_back(ptr);
+
+    _needUpdate = true;
+
+    return ptr;
+}
+
+std::shared_ptr<Plot> GUIManager::createPlot(GUIPos x, GUIPos y, int width, int height){
+
+    auto ptr = std::make_shared<Plot>(x,y,width,height);
+
+    _ELEMENTS.push_back(ptr);
+
+    _needUpdate = true;
+
+    return ptr;
+}
+
 void GUIManager::putElement(std::shared_ptr<GUI_Element> object){
 
     _ELEMENTS.push_back(object);
@@ -323,6 +392,8 @@ void GUIManager::putElement(std::shared_ptr<GUI_Element> object){
 
 void GUIManager::withdrawElement(std::shared_ptr<GUI_Element> object){
 
+    applyPendingMove();
+
     std::size_t i;
     bool found = false;
 
@@ -350,24 +421,173 @@ void GUIManager::loadVBO(){
         _needUpdate = false;
 }
 
-void GUIManager::render(){
+inline void extendBounds(const std::vector<vboData>& data, float& minX, float& minY, float& maxX, float& maxY){
+
+    for (std::size_t i = 0; i < data.size(); i++){
+
+        for (int j = 0; j < PINGUI_QUAD_VERTICES; j++){
+
+            const PinGUI::VertexPosition& pos = data[i].vertices[j].position;
+
+            minX = std::min(minX,pos.x);
+            minY = std::min(minY,pos.y);
+            maxX = std::max(maxX,pos.x);
+            maxY = std::max(maxY,pos.y);
+        }
+    }
+}
+
+bool GUIManager::getBounds(PinGUI::Rect& bounds){
+
+    float minX = FLT_MAX, minY = FLT_MAX;
+    float maxX = -FLT_MAX, maxY = -FLT_MAX;
+
+    _spriteStore.extendBounds(minX,minY,maxX,maxY);
+
+    //Store is moved by _translation only once the data are prepared
+    minX += _translation.x;
+    maxX += _translation.x;
+    minY += _translation.y;
+    maxY += _translation.y;
+
+    extendBounds(_texter->getVertexData(),minX,minY,maxX,maxY);
+
+    if (minX > maxX || minY > maxY)
+        return false;
+
+    //Whole pixels
+    bounds.x = std::floor(minX);
+    bounds.y = std::floor(minY);
+    bounds.w = int(std::ceil(maxX) - bounds.x);
+    bounds.h = int(std::ceil(maxY) - bounds.y);
+
+    return true;
+}
+
+void GUIManager::upload(){
+
+    //Nothing happens here in case PINGUI::render already prepared the data on the workers
+    prepareRender();
+
+    if (_vboPrepared){
+
+        _vboPrepared = false;
+        _revision++;
+
+        if (PinGUI::DamageTracker::isEnabled()){
+
+            PinGUI::DamageTracker::addChanges(_uploadedDATA,_vboDATA);
+            _uploadedDATA = _vboDATA;
+        }
+
+        loadVBO();
+    }
+
+    _texter->upload();
+}
+
+void GUIManager::refresh(){
+
+    applyPendingMove();
+
+    std::size_t quad = 0;
+
+    //Elements poll their variables while drawing, here it has to happen without drawing
+    for (std::size_t i = 0; i < _ELEMENTS.size(); i++){
+
+        if (!_ELEMENTS[i]->exist())
+            continue;
+
+        std::size_t count = _ELEMENTS[i]->getSpritesCount();
+
+        if (_ELEMENTS[i]->getShow()){
+
+            //Texture changed, the vertex data may stay the same
+            if (_ELEMENTS[i]->needRedraw()){
+
+                _revision++;
+
+                for (std::size_t j = quad; j < quad + count && j < _vboDATA.size(); j++)
+                    PinGUI::DamageTracker::addQuad(_vboDATA[j]);
+            }
+
+            _ELEMENTS[i]->update();
+        }
+
+        quad += count;
+    }
+
+    upload();
+
+    //Showing or hiding doesn't touch the vertex data
+    _drawnShown.resize(_vboDATA.size(),0);
+    quad = 0;
+
+    for (std::size_t i = 0; i < _ELEMENTS.size(); i++){
+
+        if (!_ELEMENTS[i]->exist())
+            continue;
+
+        char shown = _ELEMENTS[i]->getShow();
+        std::size_t count = _ELEMENTS[i]->getSpritesCount();
+
+        for (std::size_t j = quad; j < quad + count && j < _drawnShown.size(); j++){
+
+            if (_drawnShown[j] != shown){
+
+                _drawnShown[j] = shown;
+                _revision++;
+
+                PinGUI::DamageTracker::addQuad(_vboDATA[j]);
+            }
+        }
+
+        quad += count;
+    }
 
-    if (_needUpdate || _moved)
+    _texter->refresh();
+}
+
+uint64_t GUIManager::getRevision(){
+    return _revision + _texter->getRevision();
+}
+
+bool GUIManager::needPrepare(){
+
+    return (!_vboPrepared && (_needUpdate || _moved || _storeChanged)) || _texter->needPrepare();
+}
+
+void GUIManager::prepareRender(){
+
+    if (!_vboPrepared && (_needUpdate || _moved))
     {
        if (_moved)
            _moved = false;
 
-       updateVBO();
+       buildVBOData();
+       _vboPrepared = true;
+
+    } else if (!_vboPrepared && _storeChanged){
+
+       storeVBOData();
+       _vboPrepared = true;
     }
 
+    _texter->prepareRender();
+}
+
+void GUIManager::render(){
+
+    upload();
+
     //Rendering all the different data
-    glBindVertexArray(_vboMANAGER->getVAO());
+    _vboMANAGER->bind();
 
     renderElements();
 
     renderText();
 
-    glBindVertexArray(0);
+    PinGUI::GL_StateManager::bindVertexArray(0);
 }
 
 void GUIManager::renderElements(){
@@ -380,10 +600,21 @@ void GUIManager::renderElements(){
 
             if (!_ELEMENTS[i]->exist()){
 
+                //Elements behind it would take the place of the waiting ones
+                applyPendingMove();
+
                 _ELEMENTS.erase(_ELEMENTS.begin()+i);
                 i--;
                 continue;
             }
+
+            //Outside of the window camera - only skipping its data
+            if (_ELEMENTS[i]->isCulled()){
+
+                tmpPos += int(_ELEMENTS[i]->getSpritesCount());
+                continue;
+            }
+
             _ELEMENTS[i]->draw(tmpPos);
         }
     }
@@ -397,6 +628,10 @@ void GUIManager::renderText(){
 void GUIManager::update(bool allowCollision){
 
 	_texter->updateText();
+
+    //Elements catch up with the store once they can be hit or manipulated again
+    if (_manipulatingElement || PinGUI::Input_Manager::getCurrentState() != PinGUI::MANIPULATINGMOD)
+        applyPendingMove();
 	
     if (!_manipulatingElement){
 
@@ -439,6 +674,8 @@ void GUIManager::checkCrop(){
 
 void GUIManager::doCrop(){
 
+    applyPendingMove();
+
     _function.exec();
     _moved = false;
 
@@ -454,6 +691,10 @@ void GUIManager::checkCollisions(){
 
             for (std::size_t i = 0; i < _ELEMENTS.size(); i++){
 
+                //Colliders outside of the crop rect keep their old position, so culled ones can't be hit
+                if (_ELEMENTS[i]->isCulled())
+                    continue;
+
                 if (_ELEMENTS[i]->collide(_needUpdate,_manipulatingElement)){
 
                     if (_ELEMENTS[i]->getElementType() != WINDOW){
@@ -468,7 +709,15 @@ void GUIManager::checkCollisions(){
             }
         } else {
 
-            if (!_collidingElement->collide(_needUpdate,_manipulatingElement)){
+            if (_collidingElement->isCulled()){
+
+                //Scrolled away under the cursor
+                _collidingElement->turnOffAim();
+                _collidingElement = nullptr;
+
+                _needUpdate = true;
+
+            } else if (!_collidingElement->collide(_needUpdate,_manipulatingElement)){
 				
                 _collidingElement = nullptr;
 
@@ -478,18 +727,62 @@ void GUIManager::checkCollisions(){
     }
 }
 
-void GUIManager::updateVBO(){
+void GUIManager::buildVBOData(){
 
-    if (_vboDATA.size()!=0)
-        _vboDATA.clear();
+    applyPendingMove();
+
+    std::size_t spritesCount = 0;
 
     for (std::size_t i = 0; i < _ELEMENTS.size(); i++){
 
         if (_ELEMENTS[i]->exist())
-            _ELEMENTS[i]->loadData(&_vboDATA);
+            spritesCount += _ELEMENTS[i]->getSpritesCount();
     }
 
-    loadVBO();
+    //Storage is only resized and overwritten, so it allocates just when the GUI grows
+    _vboDATA.resize(spritesCount);
+
+    std::size_t pos = 0;
+
+    for (std::size_t i = 0; i < _ELEMENTS.size(); i++){
+
+        if (_ELEMENTS[i]->exist())
+            pos += _ELEMENTS[i]->loadData(_vboDATA.data()+pos);
+    }
+
+    _spriteStore.load(_vboDATA.data(),_vboDATA.size());
+
+    //Sprites keep their own alphas, the fade is only in the vertex data
+    if (_alpha != 255)
+        _spriteStore.store(_vboDATA.data(),_vboDATA.size(),_alpha);
+
+    //Sprites were already moved, the new data contain the movement
+    _translation = PinGUI::Vector2<GUIPos>(0,0);
+    _storeChanged = false;
+}
+
+void GUIManager::storeVBOData(){
+
+    _spriteStore.translate(_translation.x,_translation.y);
+    _spriteStore.store(_vboDATA.data(),_vboDATA.size(),_alpha);
+
+    _translation = PinGUI::Vector2<GUIPos>(0,0);
+    _storeChanged = false;
+}
+
+void GUIManager::applyPendingMove(){
+
+    if (_pendingElements == 0)
+        return;
+
+    for (std::size_t i = 0; i < _pendingElements && i < _ELEMENTS.size(); i++){
+
+        if (_ELEMENTS[i]->exist() && !_ELEMENTS[i]->getNetworking() && _ELEMENTS[i]->canDeferMove())
+            _ELEMENTS[i]->moveElement(_pendingMove);
+    }
+
+    _pendingMove = PinGUI::Vector2<GUIPos>(0,0);
+    _pendingElements = 0;
 }
 
 std::shared_ptr<TextManager> GUIManager::getTextManager(){
@@ -505,7 +798,47 @@ void GUIManager::moveGUI(PinGUI::Vector2<GUIPos> vect, bool croppedMovement){
 
     _texter->moveTextManager(vect,croppedMovement);
 
+    //Elements added since the last movement would get it as well
+    if (_pendingElements != _ELEMENTS.size())
+        applyPendingMove();
+
+    bool wholeGUI = !croppedMovement;
+    std::size_t spritesCount = 0;
+
+    for (std::size_t i = 0; i < _ELEMENTS.size() && wholeGUI; i++){
+
+        if (!_ELEMENTS[i]->exist())
+            continue;
+
+        if (_ELEMENTS[i]->getNetworking())
+            wholeGUI = false;
+
+        spritesCount += _ELEMENTS[i]->getSpritesCount();
+    }
+
+    //Every built quad moves by the same vector - the store translates them instead of collecting them from the sprites,
+    //and the sprites of the elements that allow it are moved only once something needs them
+    if (wholeGUI && spritesCount == _spriteStore.getQuadCount() && spritesCount == _vboDATA.size()){
+
+        for (std::size_t i = 0; i < _ELEMENTS.size(); i++){
+
+            if (_ELEMENTS[i]->exist() && !_ELEMENTS[i]->canDeferMove())
+                _ELEMENTS[i]->moveElement(vect);
+        }
+
+        _pendingMove += vect;
+        _pendingElements = _ELEMENTS.size();
+
+        _translation += vect;
+        _storeChanged = true;
+
+        return;
+    }
+
+    applyPendingMove();
+
     for (std::size_t i = 0; i < _ELEMENTS.size(); i++){
+
         if (_ELEMENTS[i]->exist() && !_ELEMENTS[i]->getNetworking())
             _ELEMENTS[i]->moveElement(vect);
     }
@@ -519,6 +852,8 @@ std::size_t GUIManager::getGUISize(){
 
 std::shared_ptr<GUI_Element> GUIManager::getGuiElement(unsigned int position){
 
+    applyPendingMove();
+
     if (position<_ELEMENTS.size() && position >= 0)
         return _ELEMENTS[position];
     else
@@ -533,6 +868,8 @@ void GUIManager::setUpdate(bool state){
 
 std::shared_ptr<GUI_Element> GUIManager::getLastGuiElement(){
 
+    applyPendingMove();
+
     if (_ELEMENTS.size()>0)
         return _ELEMENTS.back();
     else
@@ -542,28 +879,75 @@ std::shared_ptr<GUI_Element> GUIManager::getLastGuiElement(){
 }
 
 std::vector<std::shared_ptr<GUI_Element>>* GUIManager::getElementVector(){
+
+    applyPendingMove();
+
     return &_ELEMENTS;
 }
 
 std::shared_ptr<GUI_Element> GUIManager::getCollidingElement(){
+
+    applyPendingMove();
+
     return _collidingElement;
 }
 
 void GUIManager::normalizeElements(float x, float y){
 
+    applyPendingMove();
+
     PinGUI::Vector2<GUIPos> normalizedVector(x,y);
 
+    std::size_t quad = 0;
+
     for (std::size_t i = 0; i < _ELEMENTS.size(); i++){
 
-        if ( _ELEMENTS[i]->exist() && !_ELEMENTS[i]->getNetworking())
-            _ELEMENTS[i]->normalizeElement(normalizedVector);
+        if (!_ELEMENTS[i]->exist())
+            continue;
+
+        std::size_t count = _ELEMENTS[i]->getSpritesCount();
+
+        if (!_ELEMENTS[i]->getNetworking()){
+
+            if (count > 0){
+
+                //Normalization moves every sprite of the element by the same vector, the store moves its quads by it
+                GUI_Sprite* sprite = _ELEMENTS[i]->getSprite().get();
+
+                GUIPos oldX = sprite->getX();
+                GUIPos oldY = sprite->getY();
+
+                _ELEMENTS[i]->normalizeElement(normalizedVector);
+
+                _spriteStore.translateRange(quad,count,sprite->getX() - oldX,sprite->getY() - oldY);
+
+            } else {
+
+                _ELEMENTS[i]->normalizeElement(normalizedVector);
+            }
+        }
+
+        quad += count;
     }
 
+    if (quad == _spriteStore.getQuadCount() && quad == _vboDATA.size())
+        _storeChanged = true;
+    else
+        _needUpdate = true;
+
     _texter->normalizeText(normalizedVector);
 }
 
+void GUIManager::setAlpha(GLubyte alpha){
+
+    _alpha = alpha;
+    _storeChanged = true;
+}
+
 void GUIManager::moveGUITo(PinGUI::Vector2<GUIPos> vect){
 
+    applyPendingMove();
+
     for (std::size_t i = 0; i < _ELEMENTS.size(); i++){
 
         if (!_ELEMENTS[i]->getNetworking())
@@ -573,6 +957,7 @@ void GUIManager::moveGUITo(PinGUI::Vector2<GUIPos> vect){
 
 void GUIManager::cropGUI(PinGUI::Rect& rect){
 
+    applyPendingMove();
 
     for (std::size_t i = 0; i < _ELEMENTS.size(); i++){
 
@@ -599,5 +984,8 @@ clipboardData GUIManager::getClipboardData(){
 }
 
 void GUIManager::putElementAtStart(std::shared_ptr<GUI_Element> object){
+
+    applyPendingMove();
+
     _ELEMENTS.insert(_ELEMENTS.begin(),object);
 }
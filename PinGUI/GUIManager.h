@@ -36,6 +36,8 @@
 #include "GUI_ColorManager.h"
 #include "CameraManager.h"
 #include "VBO_Manager.h"
+#include "DamageTracker.h"
+#include "SpriteStore.h"
 #include <memory>
 
 /*** GUI ELEMENTS ***/
@@ -45,7 +47,11 @@
 #include "GUI_Elements/CrossBox.h"
 #include "GUI_Elements/ComboBox.h"
 #include "GUI_Elements/Image.h"
+#include "GUI_Elements/StreamingImage.h"
+#include "GUI_Elements/TiledImage.h"
 #include "GUI_Elements/Button.h"
+#include "GUI_Elements/Table.h"
+#include "GUI_Elements/Plot.h"
 
 #define BUTTON_TYPES 2
 
@@ -63,6 +69,22 @@ class GUIManager
         //Vector of vectors for each kind of button type
         std::vector<vboData> _vboDATA;
 
+        //Positions and alphas of _vboDATA for moving and fading the whole GUI
+        PinGUI::SpriteStore _spriteStore;
+
+        //Movement of the whole GUI since the vertex data were built, applied to the store
+        PinGUI::Vector2<GUIPos> _translation;
+
+        //Movement the first _pendingElements elements haven't got yet - the store owns their positions till they're needed
+        PinGUI::Vector2<GUIPos> _pendingMove;
+        std::size_t _pendingElements;
+
+        //Fade of all the quads, 255 keeps the alphas of the sprites
+        GLubyte _alpha;
+
+        //Store changed since the vertex data were built
+        bool _storeChanged;
+
         //Storage place for clipboards
         std::vector<std::shared_ptr<GUI_Element>> _ELEMENTS;
 
@@ -78,6 +100,17 @@ class GUIManager
         bool _needUpdate;
         bool _moved;
 
+        //Vertex data are built and wait for the upload on the GL thread
+        bool _vboPrepared;
+
+        //Damage tracking - data of the last upload and drawn visibility of its quads
+        std::vector<vboData> _uploadedDATA;
+
+        std::vector<char> _drawnShown;
+
+        //Grows with every change of the drawn image
+        uint64_t _revision;
+
         //Bool for manipulating mod
         bool _manipulatingMod;
 
@@ -88,7 +121,13 @@ class GUIManager
         **/
 
         void loadVBO();
-        void updateVBO();
+        void buildVBOData();
+
+        //Writes the moved and faded store back to the built vertex data
+        void storeVBOData();
+
+        //Elements get the whole GUI movement they've been waiting for
+        void applyPendingMove();
 
         //Rendering methods - for each button type
         void renderElements(); //Clipboards are first because sometime i want to put the text over the clipboard
@@ -114,6 +153,9 @@ class GUIManager
         void createComboBox(GUIPos x, GUIPos y, std::vector<std::string> items, int maxNumOfItems);
         void createComboBox(GUIPos x, GUIPos y, std::vector<std::string> items, int maxSize, int maxNumOfItems);
 
+        //Only the visible rows are created and rebound while scrolling - for very long lists
+        void createVirtualComboBox(GUIPos x, GUIPos y, std::vector<std::string> items, int maxSize, int maxNumOfItems);
+
         void createArrowBoard(GUIPos x, GUIPos y, int* var, int maxSize, bool clickable = true, int minSize = 0, PinGUI::manipulationState state = PinGUI::HORIZONTAL);
         void createArrowBoard(GUIPos x, GUIPos y, float* var, int maxSize, bool clickable = true, int minSize = 0, PinGUI::manipulationState state = PinGUI::HORIZONTAL);
 
@@ -122,9 +164,21 @@ class GUIManager
 
         void createCheckBox(GUIPos x, GUIPos y, bool* var);
 
+        //Cell text is pulled through cellFunction, only for the rows that are visible
+        std::shared_ptr<Table> createTable(GUIPos x, GUIPos y, std::vector<int> columnWidths, std::size_t rowCount, unsigned int visibleRows, PinGUI::tableFuncPointer cellFunction);
+
+        //Samples are set through the returned plot, it keeps only a pointer to them
+        std::shared_ptr<Plot> createPlot(GUIPos x, GUIPos y, int width, int height);
+
         void createImage(SDL_Surface* imageSurface, GUIPos x, GUIPos y);
         void createImage(SDL_Surface* imageSurface, GUIPos x, GUIPos y, int width, int height);
 
+        //Frames are pushed through the returned image with updatePixels
+        std::shared_ptr<StreamingImage> createStreamingImage(GUIPos x, GUIPos y, int width, int height, GLenum format = GL_RGBA);
+
+        //Big image shown in a width x height view, pan and zoom through the returned image
+        std::shared_ptr<TiledImage> createTiledImage(SDL_Surface* imageSurface, GUIPos x, GUIPos y, int width, int height);
+
         void createButton(GUIPos x, GUIPos y, std::string name, PinGUI::basicPointer f);
         void createButton(GUIPos x, GUIPos y, std::string name, PinGUI::basicPointer f, int maxSize);
 
@@ -142,6 +196,24 @@ class GUIManager
         void putElementAtStart(std::shared_ptr<GUI_Element> object);
         void withdrawElement(std::shared_ptr<GUI_Element> object);
 
+        //Builds the vertex data without touching GL - can run on a worker, render() then only uploads
+        void prepareRender();
+
+        bool needPrepare();
+
+        //Uploads the prepared vertex data, damaged areas go to the DamageTracker
+        void upload();
+
+        //Per frame update of the elements without drawing them, then upload and visibility changes
+        //Used by the cached rendering modes, where the elements aren't drawn every frame
+        void refresh();
+
+        //Changes only when the drawn image of the GUIManager changed
+        uint64_t getRevision();
+
+        //Area covered by the prepared vertex data of elements and texts, false if there is nothing
+        bool getBounds(PinGUI::Rect& bounds);
+
         //Rendering method
         void render();
 
@@ -176,6 +248,9 @@ class GUIManager
 
         void normalizeElements(float x, float y);
 
+        //Fades all the quads of the GUI, the alphas of the sprites stay
+        void setAlpha(GLubyte alpha);
+
 };
 
 #endif // GUIMANAGER_H
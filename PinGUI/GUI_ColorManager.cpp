@@ -24,7 +24,11 @@
 
 #include "GUI_ColorManager.h"
 
-SDL_Color GUI_ColorManager::_COLORS[COLOR_NUM];
+thread_local SDL_Color GUI_ColorManager::_COLORS[COLOR_NUM];
+
+void GUI_ColorManager::swapContext(contextState& state){
+    std::swap(_COLORS,state.colors);
+}
 
 void GUI_ColorManager::initColors(){
 
@@ -26,6 +26,7 @@
 **/
 
 #include <SDL.h>
+#include <utility>
 
 #define COLOR_NUM 2
 
@@ -51,8 +52,15 @@ enum colorType{
 
 class GUI_ColorManager{
     private:
-        static SDL_Color _COLORS[COLOR_NUM];
+        static thread_local SDL_Color _COLORS[COLOR_NUM];
     public:
+        //Colors of one PinGUI::Context
+        struct contextState{
+            SDL_Color colors[COLOR_NUM] = {};
+        };
+
+        static void swapContext(contextState& state);
+
         static void initColors();
 
         static void changeColor(SDL_Color color, colorType type);
@@ -25,7 +25,11 @@
 #include "GUI_Cursor.h"
 #include <iostream>
 
-PinGUI::Rect GUI_Cursor::_collisionRect;
+thread_local PinGUI::Rect GUI_Cursor::_collisionRect;
+
+void GUI_Cursor::swapContext(contextState& state){
+    std::swap(_collisionRect,state.collisionRect);
+}
 
 void GUI_Cursor::initCursor(){
 
@@ -26,6 +26,7 @@
 **/
 
 #include "SDL.h"
+#include <utility>
 
 #include "PinGUI_Rect.hpp"
 #include "Input_Manager.h"
@@ -37,9 +38,16 @@
 class GUI_Cursor
 {
     private:
-        static PinGUI::Rect _collisionRect;
+        static thread_local PinGUI::Rect _collisionRect;
     public:
 
+        //Cursor state of one PinGUI::Context
+        struct contextState{
+            PinGUI::Rect collisionRect;
+        };
+
+        static void swapContext(contextState& state);
+
         static void initCursor();
 
         static void updateCursor();
@@ -28,9 +28,10 @@
 GUI_Element::GUI_Element():
     _collidable(true),
     _show(true),
+    _exist(true),
     _networkedElement(false),
     _allowCropp(true),
-    _exist(true)
+    _culled(false)
 {
 }
 
@@ -192,12 +193,10 @@ void GUI_Element::draw(int& pos){
 
         for (std::size_t i = 0; i < _SPRITES.size(); i++){
 
-            glBindTexture(GL_TEXTURE_2D,getTexture(int(i)));
-            glDrawArrays(GL_TRIANGLES,pos*6,6);
+            PinGUI::GL_StateManager::bindTexture(getTexture(int(i)));
+            VBO_Manager::drawQuads(pos);
             pos++;
         }
-
-        glBindTexture(GL_TEXTURE_2D,0);
     } else {
 
         pos += int(_SPRITES.size());
@@ -219,6 +218,15 @@ void GUI_Element::loadData(std::vector<vboData>* vboData){
     }
 }
 
+std::size_t GUI_Element::loadData(vboData* destination){
+
+    for (std::size_t i = 0; i < _SPRITES.size(); i++){
+        destination[i] = *getVBOData(int(i));
+    }
+
+    return _SPRITES.size();
+}
+
 std::shared_ptr<GUI_Sprite> GUI_Element::getSprite(unsigned int pos){
 
     if (pos!=-1 && (pos>=0 && pos<_SPRITES.size()))
@@ -299,6 +307,10 @@ std::size_t GUI_Element::getCollidersCount(){
     return _COLLIDERS.size();
 }
 
+std::size_t GUI_Element::getSpritesCount(){
+    return _SPRITES.size();
+}
+
 elementType GUI_Element::getElementType(){
     return UNDEFINED;
 }
@@ -363,9 +375,14 @@ PinGUI::Vector2<GUIPos>* GUI_Element::getPositionVector_P(){
 
 void GUI_Element::cropElement(PinGUI::Rect& rect){
 
+    _culled = !_SPRITES.empty();
+
     for (std::size_t i = 0; i <_SPRITES.size(); i++){
 
         CropManager::cropSprite(_SPRITES[i].get(),rect);
+
+        if (!_SPRITES[i]->isCulled())
+            _culled = false;
     }
 
     for (std::size_t i = 0; i < _COLLIDERS.size(); i++){
@@ -394,6 +411,10 @@ bool GUI_Element::exist(){
     return _exist;
 }
 
+bool GUI_Element::isCulled(){
+    return _culled;
+}
+
 bool GUI_Element::isAiming(){
     return _aimON;
 }
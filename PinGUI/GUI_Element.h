@@ -58,7 +58,9 @@ enum elementType{
     HORIZONTAL_SCROLLER,
     VERTICAL_SCROLLER,
     COMBOBOX,
-    COMBOBOX_ITEM
+    COMBOBOX_ITEM,
+    TABLE,
+    PLOT
 };
 
 enum CHANGER{
@@ -88,6 +90,9 @@ class GUI_Element : public std::enable_shared_from_this<GUI_Element>
 
 		bool _allowCropp;
 
+		//Whole element lies outside of the last crop rect - it isn't drawn or hit
+		bool _culled;
+
 		/**
 			Private methods
 		**/
@@ -116,6 +121,8 @@ class GUI_Element : public std::enable_shared_from_this<GUI_Element>
 
         std::size_t getCollidersCount();
 
+        std::size_t getSpritesCount();
+
 		virtual void atWithdraw() {};
 
 		virtual bool cursorOn();
@@ -143,6 +150,9 @@ class GUI_Element : public std::enable_shared_from_this<GUI_Element>
 
         virtual void update(){};
 
+        //Element changes its look on its own in the next update() - e.g. polled variable
+        virtual bool needRedraw(){ return false; }
+
 		virtual bool changed() { return false;}
 
         virtual void info();
@@ -157,6 +167,9 @@ class GUI_Element : public std::enable_shared_from_this<GUI_Element>
 
         virtual void moveTo(PinGUI::Vector2<GUIPos> vect);
 
+        //Opt-in for elements whose moving only moves their sprites and colliders - a whole GUI movement can reach them later
+        virtual bool canDeferMove(){ return false; }
+
         virtual void cropElement(PinGUI::Rect& rect);
 
         virtual void doAdditionalFunc(){};
@@ -173,6 +186,8 @@ class GUI_Element : public std::enable_shared_from_this<GUI_Element>
 
         bool isAllowedCrop();
 
+        bool isCulled();
+
         //Normal methods
         GLuint getTexture(int pos = 0);
 
@@ -193,6 +208,9 @@ class GUI_Element : public std::enable_shared_from_this<GUI_Element>
 
         void loadData(std::vector<vboData>* vboData);
 
+        //Writes the sprite data to the destination, returns the number of written sprites
+        std::size_t loadData(vboData* destination);
+
         void moveCollider(GUIRect& rect,const PinGUI::Vector2<GUIPos>& vect);
 
         void moveCollider(PinGUI::Rect& rect,const PinGUI::Vector2<GUIPos>& vect);
@@ -401,6 +401,12 @@ void ClipBoard::moveElement(const PinGUI::Vector2<GUIPos>& vect){
 	  _textStorage->getText()->moveText(vect);
 }
 
+bool ClipBoard::canDeferMove(){
+
+    //Text is moved by the clipboard, it can't wait
+    return !containsText();
+}
+
 bool ClipBoard::listenForClick(manip_Element manipulatingElement){
 
     if (!PinGUI::Input_Manager::hasAlreadyClicked()){
@@ -449,8 +455,13 @@ void ClipBoard::cropElement(PinGUI::Rect& rect){
 
     GUI_Element::cropElement(rect);
 
-	if (containsText())
+	if (containsText()){
+
 		CropManager::cropSprite(_textStorage->getText()->getSprite().get(),rect);
+
+		//TextManager doesn't know about this crop
+		_textStorage->getText()->spriteChanged();
+	}
 }
 
 void ClipBoard::setMinValue(int minV){
@@ -158,6 +158,8 @@ class ClipBoard: public GUI_Element
 
         void moveElement(const PinGUI::Vector2<GUIPos>& vect) override;
 
+        bool canDeferMove() override;
+
         void cropElement(PinGUI::Rect& rect) override;
 
         void setClipboardText(std::string text);
@@ -31,14 +31,19 @@ ComboBox::ComboBox(GUIPos x,
                    clipboardData data,
                    std::vector<std::shared_ptr<GUI_Element>>* ELEMENTS,
                    int maxNumOfItems,
-                   bool* update):
-    _maxNumberOfItems(maxNumOfItems),
-    _needUpdate(update),
+                   bool* update,
+                   bool virtualItems):
+    _ELEMENTS(ELEMENTS),
     _scroller(nullptr),
+    _virtualItems(virtualItems),
+    _rowShift(0.0f),
+    _listShown(false),
+    _selectedOption(0),
+    _maxNumberOfItems(maxNumOfItems),
     _mainItem(nullptr),
-    _ELEMENTS(ELEMENTS),
-    _clickable(true),
-    _rollbackVect(0,0)
+    _needUpdate(update),
+    _rollbackVect(0,0),
+    _clickable(true)
 {
     _position.x = x;
     _position.y = y;
@@ -51,8 +56,13 @@ ComboBox::ComboBox(GUIPos x,
 
     initMainSprites(x,y,data);
 
-    for (std::size_t i = 0; i < itemList.size(); i++)
-        addItem(itemList[i]);
+    if (_virtualItems)
+        _STRINGS = std::move(itemList);
+
+    const std::vector<std::string>& items = _virtualItems ? _STRINGS : itemList;
+
+    for (std::size_t i = 0; i < items.size() && (!_virtualItems || i <= _maxNumberOfItems); i++)
+        createItem(items[i]);
 
     initScroller();
 }
@@ -64,14 +74,19 @@ ComboBox::ComboBox(GUIPos x,
                    std::vector<std::shared_ptr<GUI_Element>>* ELEMENTS,
                    int maxNumOfItems,
                    bool* update,
-                   int maxSize):
-    _maxNumberOfItems(maxNumOfItems),
-    _needUpdate(update),
+                   int maxSize,
+                   bool virtualItems):
+    _ELEMENTS(ELEMENTS),
     _scroller(nullptr),
+    _virtualItems(virtualItems),
+    _rowShift(0.0f),
+    _listShown(false),
+    _selectedOption(0),
+    _maxNumberOfItems(maxNumOfItems),
     _mainItem(nullptr),
-    _ELEMENTS(ELEMENTS),
-    _clickable(true),
-    _rollbackVect(0,0)
+    _needUpdate(update),
+    _rollbackVect(0,0),
+    _clickable(true)
 
 {
     _position.x = x;
@@ -83,8 +98,13 @@ ComboBox::ComboBox(GUIPos x,
 
     initMainSprites(x,y,data);
 
-    for (std::size_t i = 0; i < itemList.size(); i++)
-        addItem(itemList[i]);
+    if (_virtualItems)
+        _STRINGS = std::move(itemList);
+
+    const std::vector<std::string>& items = _virtualItems ? _STRINGS : itemList;
+
+    for (std::size_t i = 0; i < items.size() && (!_virtualItems || i <= _maxNumberOfItems); i++)
+        createItem(items[i]);
 
     initScroller();
 }
@@ -137,10 +157,10 @@ void ComboBox::initScroller(){
     _cropRect.rect.x = getSprite()->getX();
 
     int num;
-    if (_ITEMS.size()>=_maxNumberOfItems)
+    if (getItemCount()>=_maxNumberOfItems)
         num = _maxNumberOfItems;
     else
-        num = int(_ITEMS.size());
+        num = int(getItemCount());
 
     _cropRect.rect.w = _offsetCollider.w;
     _cropRect.rect.h = num * _offsetCollider.h;
@@ -166,6 +186,12 @@ void ComboBox::updateCropArea(PinGUI::Vector2<GUIPos> vect){
 
     _rollbackVect += vect;
 
+    if (_virtualItems){
+
+        bindVirtualRows();
+        return;
+    }
+
     for (std::size_t i = 0; i < _ITEMS.size(); i++){
 
         _ITEMS[i]->moveElement(vect);
@@ -179,12 +205,77 @@ std::vector<std::string> ComboBox::getStringVector(){
 
     std::vector<std::string> tmp;
 
-    for (std::size_t i = 0; i < _ITEMS.size(); i++)
-        tmp.push_back(_ITEMS[i]->getStorage()->getText()->getString());
+    getStringVector(tmp);
 
     return tmp;
 }
 
+void ComboBox::bindVirtualRows(){
+
+    int rowHeight = _offsetCollider.h - BORDER_LINE;
+
+    std::size_t first = 0;
+
+    if (_rollbackVect.y > 0.0f && rowHeight > 0)
+        first = std::size_t(_rollbackVect.y) / std::size_t(rowHeight);
+
+    //Rows never move by more than one row, the list itself moves by rebinding
+    GUIPos shift = _rollbackVect.y - GUIPos(first * rowHeight);
+
+    PinGUI::Vector2<GUIPos> move(0.0f, shift - _rowShift);
+    _rowShift = shift;
+
+    for (std::size_t i = 0; i < _ITEMS.size(); i++){
+
+        std::shared_ptr<ComboBoxItem>& row = _ITEMS[i];
+
+        if (move.y != 0.0f)
+            row->moveElement(move);
+
+        std::size_t index = first + i;
+
+        if (index < _STRINGS.size()){
+
+            //Text is rasterized again only when the row shows another item
+            if (row->getOption() != int(index + 1)){
+
+                row->setOption(int(index + 1));
+                row->setClipboardText(_STRINGS[index], row->getGUICollider()->realRect);
+            }
+
+            row->setCollidable(_clickable && row->getOption() != _selectedOption);
+            row->setShow(_listShown);
+
+        } else {
+
+            row->setShow(false);
+        }
+
+        row->cropElement(_cropRect.rect);
+    }
+
+    *_needUpdate = true;
+}
+
+std::size_t ComboBox::getItemCount(){
+    return _virtualItems ? _STRINGS.size() : _ITEMS.size();
+}
+
+void ComboBox::getStringVector(std::vector<std::string>& output){
+
+    if (_virtualItems){
+
+        output.assign(_STRINGS.begin(),_STRINGS.end());
+        return;
+    }
+
+    //Reusing the strings already in the output, so repeated calls don't allocate
+    output.resize(_ITEMS.size());
+
+    for (std::size_t i = 0; i < _ITEMS.size(); i++)
+        output[i].assign(_ITEMS[i]->getStorage()->getText()->getString());
+}
+
 void ComboBox::findLongestWord(std::vector<std::string>& itemList){
 
     for (std::size_t i = 0; i < itemList.size(); i++){
@@ -196,6 +287,31 @@ void ComboBox::findLongestWord(std::vector<std::string>& itemList){
 
 void ComboBox::addItem(std::string name){
 
+    if (_virtualItems){
+
+        _STRINGS.push_back(name);
+
+        //Rows are recycled, only the visible ones exist
+        if (_ITEMS.size() <= _maxNumberOfItems){
+
+            createItem(_STRINGS.back());
+
+            PinGUI::Vector2<GUIPos> shift(0.0f,_rowShift);
+            _ITEMS.back()->moveElement(shift);
+        }
+
+        if (_listShown)
+            bindVirtualRows();
+
+        *_needUpdate = true;
+        return;
+    }
+
+    createItem(name);
+}
+
+void ComboBox::createItem(const std::string& name){
+
     PinGUI::Vector2<GUIPos> tmpPos (_position.x, getPosOfNextItem());
 
     PinGUI::basicPointer f(boost::bind(&ComboBox::uploadContent,this));
@@ -214,6 +330,18 @@ void ComboBox::addItem(std::string name){
 
 void ComboBox::deleteItem(std::string name){
 
+    if (_virtualItems){
+
+        _STRINGS.erase(std::remove(_STRINGS.begin(),_STRINGS.end(),name),_STRINGS.end());
+
+        //Items after the deleted ones moved, every row has to be bound again
+        for (std::size_t i = 0; i < _ITEMS.size(); i++)
+            _ITEMS[i]->setOption(0);
+
+        bindVirtualRows();
+        return;
+    }
+
     for (std::size_t i = 0; i < _ITEMS.size(); i++){
 
         if (_ITEMS[i]->getStorage()->getText()->getString()==name){
@@ -233,6 +361,7 @@ void ComboBox::clearComboBox(){
         _ITEMS[i]->setExist(false);
     }
     _ITEMS.clear();
+    _STRINGS.clear();
 }
 
 void ComboBox::reMoveTabs(){
@@ -275,6 +404,8 @@ void ComboBox::onClick(){
         return;
     }
 
+    _listShown = true;
+
     for (std::size_t i = 0; i < _ITEMS.size(); i++)
         _ITEMS[i]->setShow(true);
 
@@ -286,12 +417,12 @@ void ComboBox::onClick(){
     _cropRect.rect.w = _offsetCollider.w;
     _cropRect.rect.h = _maxNumberOfItems * (_offsetCollider.h-BORDER_LINE);
 
-    if (_ITEMS.size()>_maxNumberOfItems){
+    if (getItemCount()>_maxNumberOfItems){
 
         _cropRect.rect.w += PINGUI_WINDOW_DEFAULT_SCROLLER_W-BORDER_LINE;
         _cropRect.rect.h = _maxNumberOfItems * (_offsetCollider.h-BORDER_LINE);
     } else {
-        _cropRect.rect.h = int(_ITEMS.size()) * (_offsetCollider.h-BORDER_LINE);
+        _cropRect.rect.h = int(getItemCount()) * (_offsetCollider.h-BORDER_LINE);
     }
 
     _cropRect.rect.y = _offsetCollider.y - _cropRect.rect.h;
@@ -300,7 +431,7 @@ void ComboBox::onClick(){
 
     PinGUI::Input_Manager::setTarget(true,_cropRect.rect);
 
-    if (_maxNumberOfItems< _ITEMS.size()){
+    if (_maxNumberOfItems< getItemCount()){
 
         loadScroller();
         _scroller->setShow(true);
@@ -316,7 +447,7 @@ void ComboBox::onClick(){
 
 void ComboBox::loadScroller(){
 
-    _scroller->loadScrollMover(_cropRect.rect.h,(int(_ITEMS.size()) * (_offsetCollider.h-1)));
+    _scroller->loadScrollMover(_cropRect.rect.h,(int(getItemCount()) * (_offsetCollider.h-1)));
 }
 
 bool ComboBox::listenForClick(manip_Element manipulatingElement){
@@ -326,16 +457,27 @@ bool ComboBox::listenForClick(manip_Element manipulatingElement){
 
 void ComboBox::hideContent(){
 
-    _rollbackVect.y *= -1;
+    _listShown = false;
 
-    updateCropArea(_rollbackVect);
+    if (_virtualItems){
+
+        //Rows go back to the start of the list
+        _rollbackVect.clearVector();
+        bindVirtualRows();
+
+    } else {
+
+        _rollbackVect.y *= -1;
 
-    _rollbackVect.clearVector();
+        updateCropArea(_rollbackVect);
+
+        _rollbackVect.clearVector();
+    }
 
     for (std::size_t i = 0; i < _ITEMS.size(); i++)
         _ITEMS[i]->setShow(false);
 
-    if (_maxNumberOfItems< _ITEMS.size()){
+    if (_maxNumberOfItems< getItemCount()){
 
         _scroller->hideScroller();
 
@@ -348,6 +490,8 @@ void ComboBox::uploadContent(){
 
     setClipboardText(_mainItem->getStorage()->getText()->getString(),_offsetCollider);
 
+    _selectedOption = _mainItem->getOption();
+
     _func.exec(_mainItem->getOption());
 
     hideContent();
@@ -355,10 +499,16 @@ void ComboBox::uploadContent(){
 
 void ComboBox::setShow(bool state){
 
+    _listShown = state;
+
     for (std::size_t i = 0; i < _ITEMS.size(); i++)
         _ITEMS[i]->setShow(state);
 
-    if (_maxNumberOfItems< _ITEMS.size()){
+    //Rows past the end of the list stay hidden
+    if (_virtualItems)
+        bindVirtualRows();
+
+    if (_maxNumberOfItems< getItemCount()){
         loadScroller();
     }
 
@@ -51,6 +51,19 @@ class ComboBox: public ClipBoard
         //ITEMS
         std::vector<std::shared_ptr<ComboBoxItem>> _ITEMS;
 
+        //Virtual mode - items are only strings, _ITEMS are the recycled visible rows
+        bool _virtualItems;
+
+        std::vector<std::string> _STRINGS;
+
+        //Part of the scroll the rows are moved by, the rest is done by rebinding
+        GUIPos _rowShift;
+
+        bool _listShown;
+
+        //Option of the last chosen item
+        int _selectedOption;
+
         //Maximum number of Items(that are allowed without scrolling)
         unsigned int _maxNumberOfItems;
 
@@ -78,6 +91,13 @@ class ComboBox: public ClipBoard
 
         void loadCropArea(PinGUI::Vector2<GUIPos> vect);
 
+        void createItem(const std::string& name);
+
+        //Moves the rows by the scroll offset within one row and binds them to the items they show now
+        void bindVirtualRows();
+
+        std::size_t getItemCount();
+
         void updateCropArea(PinGUI::Vector2<GUIPos> vect);
 
         void findLongestWord(std::vector<std::string>& itemList);
@@ -99,8 +119,10 @@ class ComboBox: public ClipBoard
                  clipboardData data,
                  std::vector<std::shared_ptr<GUI_Element>>* ELEMENTS,
                  int maxNumOfItems,
-                 bool* update);
+                 bool* update,
+                 bool virtualItems = false);
 
+        //With virtualItems only maxNumOfItems + 1 rows are created, no matter how long the list is
         ComboBox(GUIPos x,
 				 GUIPos y,
                  std::vector<std::string> itemList,
@@ -108,7 +130,8 @@ class ComboBox: public ClipBoard
                  std::vector<std::shared_ptr<GUI_Element>>* ELEMENTS,
                  int maxNumOfItems,
                  bool* update,
-                 int maxSize);
+                 int maxSize,
+                 bool virtualItems = false);
 
         ~ComboBox();
 
@@ -118,6 +141,9 @@ class ComboBox: public ClipBoard
 
         std::vector<std::string> getStringVector();
 
+        //Fills the vector passed by the caller instead of creating a new one
+        void getStringVector(std::vector<std::string>& output);
+
         void addItem(std::string name);
 
         void deleteItem(std::string name);
@@ -128,6 +154,8 @@ class ComboBox: public ClipBoard
 
         void moveElement(const PinGUI::Vector2<GUIPos>& vect) override;
 
+        bool canDeferMove() override { return false; }
+
         void onClick() override;
 
         bool listenForClick(manip_Element manipulatingElement) override;
@@ -90,6 +90,10 @@ void CrossBox::update(){
         change();
 }
 
+bool CrossBox::needRedraw(){
+    return hasChanged();
+}
+
 void CrossBox::change(){
     _last_var = *_var;
 
@@ -59,6 +59,10 @@ class CrossBox: public GUI_Element
         void info() override;
 
         void update() override;
+
+        bool needRedraw() override;
+
+        bool canDeferMove() override { return true; }
 };
 
 #endif // CROSSBOX_H
@@ -39,6 +39,8 @@ class Image: public GUI_Element
 
         void normalizeElement(const PinGUI::Vector2<GUIPos>& vect) override;
 
+        bool canDeferMove() override { return true; }
+
 		void changeImage(SDL_Surface* imageSurface);
 };
 
@@ -0,0 +1,462 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "Plot.h"
+
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define PLOT_USE_SSE
+#endif
+
+/**
+    Extends minValue and maxValue by the samples
+**/
+inline void extendMinMax(const float* data, std::size_t count, float& minValue, float& maxValue){
+
+    std::size_t i = 0;
+
+#ifdef PLOT_USE_SSE
+    if (count >= 8){
+
+        __m128 mins = _mm_set1_ps(minValue);
+        __m128 maxs = _mm_set1_ps(maxValue);
+
+        for (; i + 4 <= count; i += 4){
+
+            __m128 values = _mm_loadu_ps(data + i);
+
+            mins = _mm_min_ps(mins,values);
+            maxs = _mm_max_ps(maxs,values);
+        }
+
+        float lanesMin[4], lanesMax[4];
+
+        _mm_storeu_ps(lanesMin,mins);
+        _mm_storeu_ps(lanesMax,maxs);
+
+        for (int j = 0; j < 4; j++){
+
+            minValue = std::min(minValue,lanesMin[j]);
+            maxValue = std::max(maxValue,lanesMax[j]);
+        }
+    }
+#endif
+
+    for (; i < count; i++){
+
+        minValue = std::min(minValue,data[i]);
+        maxValue = std::max(maxValue,data[i]);
+    }
+}
+
+Plot::Plot(GUIPos x, GUIPos y, int width, int height):
+    _samples(nullptr),
+    _capacity(0),
+    _head(0),
+    _count(0),
+    _viewFirst(0.0),
+    _viewCount(0.0),
+    _minValue(-1.0f),
+    _maxValue(1.0f),
+    _lineColor(255,255,255,255),
+    _textureID(0),
+    _vertexCount(0),
+    _plotRect(x,y,width,height),
+    _clipRect(x,y,width,height),
+    _verticesDirty(true)
+{
+    _position.x = x;
+    _position.y = y;
+
+    SDL_Surface* tmpSurface = SheetManager::createRectangle(width,height,BOARD,BORDER_LINE);
+
+    addSprite(x,y,tmpSurface);
+    addCollider(_plotRect);
+
+    //Two vertices per pixel column
+    _vboManager = std::make_unique<VBO_Manager>(std::max(1,(width * 2) / PINGUI_QUAD_VERTICES + 1),true);
+
+    initTexture();
+}
+
+Plot::~Plot()
+{
+    PinGUI::GL_StateManager::deleteTexture(_textureID);
+}
+
+void Plot::initTexture(){
+
+    const GLubyte white[4] = {255,255,255,255};
+
+    glGenTextures(1,&_textureID);
+    PinGUI::GL_StateManager::bindTexture(_textureID);
+
+    glTexImage2D(GL_TEXTURE_2D,0,GL_RGBA8,1,1,0,GL_RGBA,GL_UNSIGNED_BYTE,white);
+
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_NEAREST);
+
+    PinGUI::GL_StateManager::bindTexture(0);
+}
+
+void Plot::setData(const float* samples, std::size_t count){
+    setRingData(samples,count,0,count);
+}
+
+void Plot::setRingData(const float* buffer, std::size_t capacity, std::size_t head, std::size_t count){
+
+    bool newBuffer = (buffer != _samples || capacity != _capacity);
+
+    _samples = buffer;
+    _capacity = capacity;
+    _head = capacity > 0 ? head % capacity : 0;
+    _count = std::min(count,capacity);
+
+    //Same buffer only moved its head - the blocks are still valid
+    if (newBuffer)
+        buildLevels();
+
+    _verticesDirty = true;
+}
+
+void Plot::updateSamples(std::size_t first, std::size_t count){
+
+    if (count == 0 || _capacity == 0)
+        return;
+
+    first %= _capacity;
+
+    //Written range may wrap around the end of the ring
+    if (first + count > _capacity){
+
+        updateLevels(first,_capacity);
+        updateLevels(0,std::min(first + count - _capacity,_capacity));
+
+    } else {
+
+        updateLevels(first,first + count);
+    }
+
+    _verticesDirty = true;
+}
+
+void Plot::setView(double firstSample, double numOfSamples){
+
+    _viewFirst = std::max(0.0,firstSample);
+    _viewCount = std::max(0.0,numOfSamples);
+
+    _verticesDirty = true;
+}
+
+void Plot::setValueRange(float minValue, float maxValue){
+
+    _minValue = minValue;
+    _maxValue = maxValue;
+
+    _verticesDirty = true;
+}
+
+void Plot::setLineColor(GLubyte R, GLubyte G, GLubyte B, GLubyte A){
+
+    _lineColor.setColor(R,G,B,A);
+
+    _verticesDirty = true;
+}
+
+void Plot::buildLevels(){
+
+    _LEVELS.clear();
+
+    if (!_samples || _capacity == 0)
+        return;
+
+    std::size_t blockSize = PLOT_LOD_BLOCK;
+    std::size_t numOfBlocks = (_capacity + blockSize - 1) / blockSize;
+
+    //Every level has PLOT_LOD_FACTOR times less blocks, the last one has a single block
+    while (true){
+
+        plotLevel level;
+        level.blockSize = blockSize;
+        level.mins.resize(numOfBlocks);
+        level.maxs.resize(numOfBlocks);
+
+        _LEVELS.push_back(std::move(level));
+
+        if (numOfBlocks <= 1)
+            break;
+
+        blockSize *= PLOT_LOD_FACTOR;
+        numOfBlocks = (numOfBlocks + PLOT_LOD_FACTOR - 1) / PLOT_LOD_FACTOR;
+    }
+
+    updateLevels(0,_capacity);
+}
+
+void Plot::updateLevels(std::size_t first, std::size_t last){
+
+    if (_LEVELS.empty() || last <= first)
+        return;
+
+    std::size_t firstBlock = first / PLOT_LOD_BLOCK;
+    std::size_t lastBlock = (last - 1) / PLOT_LOD_BLOCK;
+
+    plotLevel& base = _LEVELS[0];
+
+    for (std::size_t i = firstBlock; i <= lastBlock; i++){
+
+        std::size_t start = i * PLOT_LOD_BLOCK;
+        std::size_t size = std::min<std::size_t>(PLOT_LOD_BLOCK,_capacity - start);
+
+        float minValue = FLT_MAX, maxValue = -FLT_MAX;
+
+        extendMinMax(_samples + start,size,minValue,maxValue);
+
+        base.mins[i] = minValue;
+        base.maxs[i] = maxValue;
+    }
+
+    //Coarser levels only merge the changed blocks of the finer one
+    for (std::size_t i = 1; i < _LEVELS.size(); i++){
+
+        const plotLevel& finer = _LEVELS[i-1];
+        plotLevel& level = _LEVELS[i];
+
+        firstBlock /= PLOT_LOD_FACTOR;
+        lastBlock /= PLOT_LOD_FACTOR;
+
+        for (std::size_t j = firstBlock; j <= lastBlock; j++){
+
+            std::size_t start = j * PLOT_LOD_FACTOR;
+            std::size_t end = std::min(start + PLOT_LOD_FACTOR,finer.mins.size());
+
+            float minValue = FLT_MAX, maxValue = -FLT_MAX;
+
+            for (std::size_t k = start; k < end; k++){
+
+                minValue = std::min(minValue,finer.mins[k]);
+                maxValue = std::max(maxValue,finer.maxs[k]);
+            }
+
+            level.mins[j] = minValue;
+            level.maxs[j] = maxValue;
+        }
+    }
+}
+
+void Plot::getRangeMinMax(std::size_t first, std::size_t last, int level, float& minValue, float& maxValue){
+
+    if (level < 0){
+
+        extendMinMax(_samples + first,last - first,minValue,maxValue);
+        return;
+    }
+
+    const plotLevel& lod = _LEVELS[level];
+
+    //Edges snap to the nearest block, the block is at most half of the pixel column
+    std::size_t firstBlock = (first + lod.blockSize / 2) / lod.blockSize;
+    std::size_t lastBlock = (last + lod.blockSize / 2) / lod.blockSize;
+
+    lastBlock = std::min(std::max(lastBlock,firstBlock + 1),lod.mins.size());
+    firstBlock = std::min(firstBlock,lastBlock - 1);
+
+    for (std::size_t i = firstBlock; i < lastBlock; i++){
+
+        minValue = std::min(minValue,lod.mins[i]);
+        maxValue = std::max(maxValue,lod.maxs[i]);
+    }
+}
+
+void Plot::getLogicalMinMax(std::size_t first, std::size_t last, int level, float& minValue, float& maxValue){
+
+    std::size_t start = (_head + first) % _capacity;
+    std::size_t size = last - first;
+
+    if (start + size <= _capacity){
+
+        getRangeMinMax(start,start + size,level,minValue,maxValue);
+
+    } else {
+
+        getRangeMinMax(start,_capacity,level,minValue,maxValue);
+        getRangeMinMax(0,start + size - _capacity,level,minValue,maxValue);
+    }
+}
+
+void Plot::addVertex(float x, float value){
+
+    float range = _maxValue - _minValue;
+    float y = _plotRect.y;
+
+    if (range != 0.0f)
+        y += (value - _minValue) / range * _plotRect.h;
+
+    y = std::min(std::max(y,_clipRect.y),_clipRect.y + _clipRect.h);
+
+    PinGUI::Vertex vertex;
+    vertex.setPosition(x,y);
+    vertex.color = _lineColor;
+    vertex.setUV(0.5f,0.5f);
+
+    _VERTICES.push_back(vertex);
+}
+
+void Plot::buildVertices(){
+
+    _VERTICES.clear();
+
+    double viewCount = _viewCount > 0.0 ? _viewCount : double(_count);
+
+    if (!_samples || _count == 0 || _plotRect.w <= 0 || viewCount <= 0.0 || _clipRect.w <= 0 || _clipRect.h <= 0)
+        return;
+
+    double samplesPerPixel = viewCount / _plotRect.w;
+
+    float clipLeft = _clipRect.x;
+    float clipRight = _clipRect.x + _clipRect.w;
+
+    if (samplesPerPixel < 1.0){
+
+        //Zoomed in - a line through the samples themselves
+        std::size_t first = std::size_t(_viewFirst);
+        std::size_t last = std::min(_count,std::size_t(std::ceil(_viewFirst + viewCount)) + 1);
+
+        for (std::size_t i = first; i < last; i++){
+
+            float x = _plotRect.x + float((double(i) - _viewFirst) / samplesPerPixel);
+
+            if (x < clipLeft || x > clipRight)
+                continue;
+
+            addVertex(x,_samples[(_head + i) % _capacity]);
+        }
+
+        return;
+    }
+
+    //Coarsest level whose blocks are at most half of the pixel column, raw samples for short columns
+    int level = -1;
+
+    for (std::size_t i = 0; i < _LEVELS.size(); i++){
+
+        if (double(_LEVELS[i].blockSize) * 2.0 <= samplesPerPixel)
+            level = int(i);
+    }
+
+    int firstColumn = std::max(0,int(clipLeft - _plotRect.x));
+    int lastColumn = std::min(_plotRect.w,int(std::ceil(clipRight - _plotRect.x)));
+
+    for (int column = firstColumn; column < lastColumn; column++){
+
+        double start = _viewFirst + column * samplesPerPixel;
+
+        std::size_t first = std::size_t(start);
+        std::size_t last = std::min(_count,std::size_t(start + samplesPerPixel));
+
+        if (first >= _count)
+            break;
+
+        if (last <= first)
+            last = first + 1;
+
+        float minValue = FLT_MAX, maxValue = -FLT_MAX;
+
+        getLogicalMinMax(first,last,level,minValue,maxValue);
+
+        //Strip goes through the min and max of every column
+        float x = _plotRect.x + column + 0.5f;
+
+        addVertex(x,minValue);
+        addVertex(x,maxValue);
+    }
+}
+
+void Plot::draw(int& pos){
+
+    //Background
+    GUI_Element::draw(pos);
+
+    if (!_show)
+        return;
+
+    if (_verticesDirty){
+
+        buildVertices();
+
+        _vboManager->bufferVertices(_VERTICES);
+        _vertexCount = GLsizei(_VERTICES.size());
+
+        _verticesDirty = false;
+    }
+
+    if (_vertexCount < 2)
+        return;
+
+    GLuint previousVertexArray = PinGUI::GL_StateManager::getVertexArray();
+
+    PinGUI::GL_StateManager::bindVertexArray(_vboManager->getVAO());
+    PinGUI::GL_StateManager::bindTexture(_textureID);
+
+    glDrawArrays(GL_LINE_STRIP,0,_vertexCount);
+
+    PinGUI::GL_StateManager::bindVertexArray(previousVertexArray);
+}
+
+bool Plot::needRedraw(){
+    return _verticesDirty;
+}
+
+void Plot::moveElement(const PinGUI::Vector2<GUIPos>& vect){
+
+    GUI_Element::moveElement(vect);
+
+    _plotRect.addPos(vect);
+    _clipRect.addPos(vect);
+
+    _verticesDirty = true;
+}
+
+void Plot::cropElement(PinGUI::Rect& rect){
+
+    GUI_Element::cropElement(rect);
+
+    float left = std::max(_plotRect.x,rect.x);
+    float bottom = std::max(_plotRect.y,rect.y);
+    float right = std::min(_plotRect.x + _plotRect.w,rect.x + rect.w);
+    float top = std::min(_plotRect.y + _plotRect.h,rect.y + rect.h);
+
+    _clipRect = PinGUI::Rect(left,bottom,std::max(0,int(right - left)),std::max(0,int(top - bottom)));
+
+    _verticesDirty = true;
+}
+
+elementType Plot::getElementType(){
+    return PLOT;
+}
@@ -0,0 +1,149 @@
+#ifndef PLOT_H
+#define PLOT_H
+
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include <vector>
+#include <memory>
+
+#include "../GUI_Element.h"
+#include "../VBO_Manager.h"
+
+//Samples in one block of the finest level of detail
+#define PLOT_LOD_BLOCK 8
+
+//Blocks of one level merged into one block of the next level
+#define PLOT_LOD_FACTOR 4
+
+//Min and max of the blocks of one level of detail
+struct plotLevel{
+
+    std::size_t blockSize = 0;
+    std::vector<float> mins;
+    std::vector<float> maxs;
+};
+
+/**
+    Line plot of a big sample buffer that stays owned by the application
+    Every pixel column draws the min/max of its samples, taken from a level of detail cache,
+    so zooming and panning cost depends on the width of the plot and not on the number of samples
+**/
+class Plot: public GUI_Element
+{
+    private:
+
+        //Samples - linear data or a ring buffer
+        const float* _samples;
+
+        std::size_t _capacity;
+
+        //Position of the oldest sample in the ring
+        std::size_t _head;
+
+        std::size_t _count;
+
+        //Visible samples, zero count shows all of them
+        double _viewFirst;
+
+        double _viewCount;
+
+        //Values at the bottom and the top of the plot
+        float _minValue;
+
+        float _maxValue;
+
+        PinGUI::VertexColor _lineColor;
+
+        std::vector<plotLevel> _LEVELS;
+
+        std::vector<PinGUI::Vertex> _VERTICES;
+
+        std::unique_ptr<VBO_Manager> _vboManager;
+
+        //Lines are drawn with the GUI shader, which multiplies the color by a texture
+        GLuint _textureID;
+
+        GLsizei _vertexCount;
+
+        PinGUI::Rect _plotRect;
+
+        //Part of the plot inside of the crop rect
+        PinGUI::Rect _clipRect;
+
+        bool _verticesDirty;
+
+        /**
+            Private methods
+        **/
+        void initTexture();
+
+        void buildLevels();
+
+        //Recomputes the blocks covering buffer positions [first, last)
+        void updateLevels(std::size_t first, std::size_t last);
+
+        //Min and max of buffer positions [first, last), level -1 reads the samples
+        void getRangeMinMax(std::size_t first, std::size_t last, int level, float& minValue, float& maxValue);
+
+        void getLogicalMinMax(std::size_t first, std::size_t last, int level, float& minValue, float& maxValue);
+
+        void buildVertices();
+
+        void addVertex(float x, float value);
+
+    public:
+        Plot(GUIPos x, GUIPos y, int width, int height);
+
+        ~Plot();
+
+        //The plot only reads the samples, they have to stay valid while it's drawn
+        void setData(const float* samples, std::size_t count);
+
+        //Ring buffer with the oldest of count samples at head
+        void setRingData(const float* buffer, std::size_t capacity, std::size_t head, std::size_t count);
+
+        //Samples at buffer positions [first, first + count) were written, only their blocks are recomputed
+        void updateSamples(std::size_t first, std::size_t count);
+
+        //Zoom and pan, in samples
+        void setView(double firstSample, double numOfSamples);
+
+        void setValueRange(float minValue, float maxValue);
+
+        void setLineColor(GLubyte R, GLubyte G, GLubyte B, GLubyte A = 255);
+
+        void draw(int& pos) override;
+
+        bool needRedraw() override;
+
+        void moveElement(const PinGUI::Vector2<GUIPos>& vect) override;
+
+        void cropElement(PinGUI::Rect& rect) override;
+
+        elementType getElementType() override;
+};
+
+#endif // PLOT_H
@@ -30,6 +30,8 @@ Scroller::Scroller(PinGUI::Vector2<GUIPos> pos, bool* update):
     _oldDiff(0)
 {
     _position = pos;
+
+    _wheelFunction._function = boost::bind(&Scroller::checkForWheelMove,this);
 }
 
 Scroller::~Scroller()
@@ -96,9 +98,7 @@ void Scroller::attachScrollerToInput(){
 
     if (_SPRITES.size()>1){
 
-        PinGUI::basicPointer f(boost::bind(&Scroller::checkForWheelMove,this));
-
-        PinGUI::Input_Manager::setWheeledInfo(getSprite(1),_update,f);
+        PinGUI::Input_Manager::setWheeledInfo(_SPRITES[1],_update,_wheelFunction);
     }
 }
 
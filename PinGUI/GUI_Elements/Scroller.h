@@ -58,6 +58,9 @@ class Scroller: public GUI_Element
         //This will call the camera manipulation function for window
         PinGUI::scrollFuncPointer _cameraRoll;
 
+        //Function attached to the mouse wheel, created once
+        PinGUI::basicPointer _wheelFunction;
+
         //Keep track of addition/dec of var
         float _oldPos;
 
@@ -0,0 +1,126 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "StreamingImage.h"
+
+StreamingImage::StreamingImage(GUIPos x, GUIPos y, int width, int height, GLenum format):
+    Image(SDL_CreateRGBSurfaceWithFormat(0,width,height,32,SDL_PIXELFORMAT_RGBA32),x,y),
+    _width(width),
+    _height(height),
+    _format(format),
+    _pboIndex(0),
+    _frameSize(std::size_t(width) * std::size_t(height) * 4),
+    _frameChanged(false),
+    _frames(0)
+{
+    initBuffers();
+}
+
+StreamingImage::~StreamingImage()
+{
+    for (int i = 0; i < PINGUI_STREAM_PBOS; i++)
+        PinGUI::GL_StateManager::deleteBuffer(_PBOS[i]);
+}
+
+void StreamingImage::initBuffers(){
+
+    glGenBuffers(PINGUI_STREAM_PBOS,_PBOS);
+
+    for (int i = 0; i < PINGUI_STREAM_PBOS; i++){
+
+        if (_PBOS[i] == 0)
+            ErrorManager::systemError("Cannot generate pixel buffer for streaming image!");
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER,_PBOS[i]);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER,GLsizeiptr(_frameSize),nullptr,GL_STREAM_DRAW);
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER,0);
+}
+
+void StreamingImage::updatePixels(const void* pixels, int pitch){
+
+    if (!pixels || _frameSize == 0)
+        return;
+
+    std::size_t rowSize = std::size_t(_width) * 4;
+
+    if (pitch <= 0)
+        pitch = int(rowSize);
+
+    //The other buffer may still be read by the previous upload
+    _pboIndex = (_pboIndex + 1) % PINGUI_STREAM_PBOS;
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER,_PBOS[_pboIndex]);
+
+    //Invalidating lets the driver hand out fresh memory instead of waiting for the GPU
+    void* target = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER,0,GLsizeiptr(_frameSize),
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+    if (!target){
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER,0);
+        return;
+    }
+
+    const unsigned char* source = static_cast<const unsigned char*>(pixels);
+    unsigned char* destination = static_cast<unsigned char*>(target);
+
+    if (std::size_t(pitch) == rowSize){
+
+        std::memcpy(destination,source,_frameSize);
+
+    } else {
+
+        for (int row = 0; row < _height; row++)
+            std::memcpy(destination + row * rowSize,source + std::size_t(row) * pitch,rowSize);
+    }
+
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    //Copy from the bound buffer, the call returns without waiting for the transfer
+    PinGUI::GL_StateManager::bindTexture(getSprite()->getTexture());
+
+    //Alignment of the caller is left as it was
+    GLint previousAlignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT,&previousAlignment);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT,4);
+    glTexSubImage2D(GL_TEXTURE_2D,0,0,0,_width,_height,_format,GL_UNSIGNED_BYTE,nullptr);
+    glPixelStorei(GL_UNPACK_ALIGNMENT,previousAlignment);
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER,0);
+
+    _frameChanged = true;
+    _frames++;
+}
+
+void StreamingImage::update(){
+    _frameChanged = false;
+}
+
+bool StreamingImage::needRedraw(){
+    return _frameChanged;
+}
@@ -0,0 +1,84 @@
+#ifndef STREAMINGIMAGE_H
+#define STREAMINGIMAGE_H
+
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "Image.h"
+
+//Pixel buffers the frames are rotated through
+#define PINGUI_STREAM_PBOS 2
+
+/**
+    Image whose pixels are replaced every frame - camera, video or simulation output
+    Frames are copied into pixel buffer objects and uploaded with glTexSubImage2D,
+    the texture and the buffers are allocated once
+**/
+class StreamingImage: public Image
+{
+    private:
+
+        int _width;
+
+        int _height;
+
+        //GL_RGBA or GL_BGRA, 4 bytes per pixel
+        GLenum _format;
+
+        GLuint _PBOS[PINGUI_STREAM_PBOS];
+
+        std::size_t _pboIndex;
+
+        std::size_t _frameSize;
+
+        bool _frameChanged;
+
+        uint64_t _frames;
+
+        /**
+            Private methods
+        **/
+        void initBuffers();
+
+    public:
+        StreamingImage(GUIPos x, GUIPos y, int width, int height, GLenum format = GL_RGBA);
+        ~StreamingImage();
+
+        //Pixels are copied right away, the caller can reuse the buffer after the call
+        //Rows go from the top, pitch 0 means tightly packed rows
+        void updatePixels(const void* pixels, int pitch = 0);
+
+        void update() override;
+
+        bool needRedraw() override;
+
+        int getWidth(){return _width;}
+
+        int getHeight(){return _height;}
+
+        uint64_t getFrameCount(){return _frames;}
+};
+
+#endif // STREAMINGIMAGE_H
@@ -0,0 +1,378 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "Table.h"
+
+#include <algorithm>
+
+//Recycled row that shows no data row
+#define TABLE_NO_ROW std::size_t(-1)
+
+//Scroller pixels of big tables are mapped to rows, so the floats never grow past the exact range
+#define TABLE_MAX_SCROLL_HEIGHT (1 << 20)
+
+Table::Table(GUIPos x,
+             GUIPos y,
+             std::vector<int> columnWidths,
+             std::size_t rowCount,
+             unsigned int visibleRows,
+             PinGUI::tableFuncPointer cellFunction,
+             clipboardData data,
+             std::vector<std::shared_ptr<GUI_Element>>* ELEMENTS,
+             bool* update):
+    _ELEMENTS(ELEMENTS),
+    _scroller(nullptr),
+    _columnWidths(columnWidths),
+    _rowCount(rowCount),
+    _visibleRows(visibleRows > 0 ? visibleRows : 1),
+    _rowHeight(1),
+    _scrollPixels(0.0f),
+    _scrollRange(0),
+    _firstRow(0),
+    _rowShift(0.0f),
+    _windowCropped(false),
+    _cellFunction(cellFunction),
+    _needUpdate(update),
+    _wheelAttached(false)
+{
+    _position.x = x;
+    _position.y = y;
+
+    createCells(data);
+
+    int width = TABLE_CELL_OVERLAP;
+
+    for (std::size_t i = 0; i < _columnWidths.size(); i++)
+        width += _columnWidths[i] - TABLE_CELL_OVERLAP;
+
+    _tableRect.rect = PinGUI::Rect(x, y, width, int(_visibleRows) * _rowHeight + TABLE_CELL_OVERLAP);
+    _tableRect.realRect = _tableRect.rect;
+
+    //Table itself has nothing to draw, the collider is there for the mouse wheel
+    addCollider(_tableRect.rect);
+
+    initScroller();
+
+    bindRows(true);
+}
+
+Table::~Table()
+{
+    _CELLS.clear();
+}
+
+void Table::createCells(clipboardData& data){
+
+    //One row more than visible - a partially scrolled row needs its own place
+    std::size_t numOfRows = _visibleRows + 1;
+
+    for (std::size_t i = 0; i < numOfRows; i++){
+
+        GUIPos cellX = _position.x;
+
+        for (std::size_t j = 0; j < _columnWidths.size(); j++){
+
+            PinGUI::Vector2<GUIPos> tmpPos(cellX, _position.y);
+
+            auto cell = std::make_shared<ClipBoard>(tmpPos, _columnWidths[j], _columnWidths[j]/WIDTH_PER_CHAR, UNCLICKABLE, data, 0, RECTANGLED);
+
+            //Table owns full control of its cells
+            cell->setNetworking(true);
+            cell->setShow(false);
+
+            _CELLS.push_back(cell);
+            _ELEMENTS->push_back(cell);
+
+            cellX += _columnWidths[j] - TABLE_CELL_OVERLAP;
+        }
+
+        _BOUND_ROWS.push_back(TABLE_NO_ROW);
+        _ROWS_Y.push_back(_position.y);
+    }
+
+    if (!_CELLS.empty())
+        _rowHeight = std::max(1, _CELLS[0]->getSprite()->getH() - TABLE_CELL_OVERLAP);
+}
+
+void Table::initScroller(){
+
+    PinGUI::Vector2<GUIPos> tmpPos(_tableRect.realRect.x + _tableRect.realRect.w - TABLE_CELL_OVERLAP, _tableRect.realRect.y);
+
+    _scroller = std::make_shared<VerticalScroller>(tmpPos,_tableRect.realRect.h,_needUpdate,_ELEMENTS);
+
+    PinGUI::scrollFuncPointer f;
+    f._function = boost::bind(&Table::scrollRows,this,_1);
+
+    _scroller->setCamRollFunction(f);
+
+    _scroller->setNetworking(true);
+
+    _ELEMENTS->push_back(_scroller);
+    _scroller->createArrows(_ELEMENTS);
+
+    loadScroller();
+}
+
+void Table::loadScroller(){
+
+    bool loaded = _scroller->getSpritesCount() > 1;
+
+    if (_rowCount <= _visibleRows){
+
+        if (loaded)
+            _scroller->hideScroller();
+        else
+            _scroller->setShow(false);
+
+        _scrollPixels = 0.0f;
+        _scrollRange = 0;
+        updateFirstRow();
+        return;
+    }
+
+    int visibleHeight = int(_visibleRows) * _rowHeight;
+
+    //Scroller works with int pixels, the rows beyond its range are reached proportionally
+    double rowsHeight = double(_rowCount) * double(_rowHeight);
+    int totalHeight = int(std::min(rowsHeight, double(std::max(TABLE_MAX_SCROLL_HEIGHT, visibleHeight * 2))));
+
+    if (loaded)
+        _scroller->reloadScroller(visibleHeight, totalHeight);
+    else
+        _scroller->loadScrollMover(visibleHeight, totalHeight);
+
+    _scroller->setShow(_show);
+
+    _scrollRange = totalHeight - visibleHeight;
+    _scrollPixels = std::min(_scrollPixels, GUIPos(_scrollRange));
+
+    updateFirstRow();
+}
+
+void Table::scrollRows(PinGUI::Vector2<GUIPos> vect){
+
+    _scrollPixels = std::max(0.0f, std::min(_scrollPixels + vect.y, GUIPos(_scrollRange)));
+
+    updateFirstRow();
+
+    bindRows();
+}
+
+void Table::updateFirstRow(){
+
+    if (_scrollRange <= 0 || _rowCount <= _visibleRows){
+
+        _firstRow = 0;
+        _rowShift = 0.0f;
+        return;
+    }
+
+    //Scroller covers every scrollable row, whatever the pixel height of them
+    std::size_t scrollableRows = _rowCount - _visibleRows;
+
+    double rowPos = double(_scrollPixels) / double(_scrollRange) * double(scrollableRows);
+
+    _firstRow = std::min(std::size_t(rowPos), scrollableRows);
+    _rowShift = GUIPos((rowPos - double(_firstRow)) * _rowHeight);
+}
+
+void Table::bindRows(bool rebindAll){
+
+    std::size_t numOfRows = _BOUND_ROWS.size();
+
+    std::size_t first = _firstRow;
+
+    //Rows never move by more than one row, the rest of the scroll is done by rebinding
+    GUIPos shift = _rowShift;
+
+    GUIPos top = _tableRect.realRect.y + _tableRect.realRect.h;
+
+    std::size_t columns = _columnWidths.size();
+
+    for (std::size_t i = first; i < first + numOfRows; i++){
+
+        //Every data row has its fixed recycled row, so scrolling by one row binds just one of them
+        std::size_t slot = i % numOfRows;
+
+        GUIPos rowY = top - GUIPos((i - first + 1) * _rowHeight) - TABLE_CELL_OVERLAP + shift;
+
+        if (rowY != _ROWS_Y[slot]){
+
+            PinGUI::Vector2<GUIPos> tmpVect(0.0f, rowY - _ROWS_Y[slot]);
+
+            for (std::size_t j = 0; j < columns; j++)
+                _CELLS[slot * columns + j]->moveElement(tmpVect);
+
+            _ROWS_Y[slot] = rowY;
+        }
+
+        if (i < _rowCount){
+
+            if (rebindAll || _BOUND_ROWS[slot] != i)
+                bindRow(slot, i);
+
+        } else {
+
+            _BOUND_ROWS[slot] = TABLE_NO_ROW;
+        }
+
+        for (std::size_t j = 0; j < columns; j++)
+            _CELLS[slot * columns + j]->setShow(_show && i < _rowCount);
+    }
+
+    cropCells();
+
+    *_needUpdate = true;
+}
+
+void Table::bindRow(std::size_t slot, std::size_t row){
+
+    _BOUND_ROWS[slot] = row;
+
+    std::size_t columns = _columnWidths.size();
+
+    for (std::size_t i = 0; i < columns; i++){
+
+        _cellText.clear();
+        _cellFunction.exec(row, i, _cellText);
+
+        //Empty string can't be rendered
+        if (_cellText.empty())
+            _cellText = " ";
+
+        ClipBoard* cell = _CELLS[slot * columns + i].get();
+
+        cell->setClipboardText(_cellText, cell->getGUICollider()->realRect);
+    }
+}
+
+void Table::cropCells(){
+
+    PinGUI::Rect cropRect = _tableRect.realRect;
+
+    //Visible part of the table inside of the window
+    if (_windowCropped){
+
+        float left = std::max(cropRect.x, _windowCropRect.x);
+        float bottom = std::max(cropRect.y, _windowCropRect.y);
+        float right = std::min(cropRect.x + cropRect.w, _windowCropRect.x + _windowCropRect.w);
+        float top = std::min(cropRect.y + cropRect.h, _windowCropRect.y + _windowCropRect.h);
+
+        cropRect = PinGUI::Rect(left, bottom, std::max(0, int(right - left)), std::max(0, int(top - bottom)));
+    }
+
+    _tableRect.rect = cropRect;
+
+    for (std::size_t i = 0; i < _CELLS.size(); i++)
+        _CELLS[i]->cropElement(cropRect);
+}
+
+void Table::setRowCount(std::size_t rowCount){
+
+    _rowCount = rowCount;
+
+    loadScroller();
+
+    bindRows(true);
+}
+
+void Table::refreshRows(){
+    bindRows(true);
+}
+
+std::size_t Table::getRowCount(){
+    return _rowCount;
+}
+
+void Table::onAim(){
+
+    if (!_scroller->getShow() || _scroller->getSpritesCount() < 2)
+        return;
+
+    PinGUI::basicPointer f;
+    f._function = boost::bind(&Scroller::checkForWheelMove,_scroller);
+
+    PinGUI::Input_Manager::setTMPWheeledInfo(_scroller->getSprite(1),_needUpdate,f);
+
+    _wheelAttached = true;
+}
+
+void Table::onEndAim(){
+
+    if (_wheelAttached){
+
+        PinGUI::Input_Manager::cancelTMPWheeledInfo();
+        _wheelAttached = false;
+    }
+}
+
+void Table::setShow(bool state){
+
+    GUI_Element::setShow(state);
+
+    _scroller->setShow(state && _rowCount > _visibleRows);
+
+    bindRows();
+}
+
+void Table::setExist(bool state){
+
+    GUI_Element::setExist(state);
+
+    _scroller->setExist(state);
+
+    for (std::size_t i = 0; i < _CELLS.size(); i++)
+        _CELLS[i]->setExist(state);
+}
+
+void Table::moveElement(const PinGUI::Vector2<GUIPos>& vect){
+
+    GUI_Element::moveElement(vect);
+    _scroller->moveElement(vect);
+
+    for (std::size_t i = 0; i < _CELLS.size(); i++)
+        _CELLS[i]->moveElement(vect);
+
+    for (std::size_t i = 0; i < _ROWS_Y.size(); i++)
+        _ROWS_Y[i] += vect.y;
+
+    moveCollider(_tableRect.realRect,vect);
+
+    cropCells();
+}
+
+void Table::cropElement(PinGUI::Rect& rect){
+
+    GUI_Element::cropElement(rect);
+
+    _windowCropRect = rect;
+    _windowCropped = true;
+
+    cropCells();
+}
+
+elementType Table::getElementType(){
+    return TABLE;
+}
@@ -0,0 +1,151 @@
+#ifndef TABLE_H
+#define TABLE_H
+
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include <boost/bind.hpp>
+
+#include "../GUI_Elements/ClipBoard.h"
+#include "../GUI_Elements/VerticalScroller.h"
+
+//Neighbouring cells share their border line
+#define TABLE_CELL_OVERLAP 1
+
+/**
+    Table of text cells for big data sets
+    Only the visible rows exist, they are recycled while scrolling and their text is pulled through the cell function
+**/
+class Table: public GUI_Element
+{
+    private:
+
+        std::vector<std::shared_ptr<GUI_Element>>* _ELEMENTS;
+
+        std::shared_ptr<VerticalScroller> _scroller;
+
+        //Cells of the recycled rows, row after row
+        std::vector<std::shared_ptr<ClipBoard>> _CELLS;
+
+        std::vector<int> _columnWidths;
+
+        //Data row shown by every recycled row
+        std::vector<std::size_t> _BOUND_ROWS;
+
+        //Bottom of every recycled row
+        std::vector<GUIPos> _ROWS_Y;
+
+        std::size_t _rowCount;
+
+        unsigned int _visibleRows;
+
+        int _rowHeight;
+
+        //Position of the scroller mover, in the scroller's own pixels
+        GUIPos _scrollPixels;
+
+        //Pixels the scroller can move through - capped, so it stays exact in float
+        int _scrollRange;
+
+        //First data row on the top of the table and the scrolled pixels of it
+        std::size_t _firstRow;
+        GUIPos _rowShift;
+
+        //Area of the visible rows
+        GUIRect _tableRect;
+
+        //Crop rect of the window the table lies in
+        PinGUI::Rect _windowCropRect;
+
+        bool _windowCropped;
+
+        PinGUI::tableFuncPointer _cellFunction;
+
+        //Text of the cell being bound - reused, so the rebinding doesn't allocate
+        std::string _cellText;
+
+        bool* _needUpdate;
+
+        //Mouse wheel is attached to the scroller while the cursor is over the table
+        bool _wheelAttached;
+
+        /**
+            Private methods
+        **/
+        void createCells(clipboardData& data);
+
+        void initScroller();
+
+        void loadScroller();
+
+        void scrollRows(PinGUI::Vector2<GUIPos> vect);
+
+        //Maps the scroller position to the first row and its shift, proportionally to the row count
+        void updateFirstRow();
+
+        //Moves every recycled row to its place and binds the rows that show another data row now
+        void bindRows(bool rebindAll = false);
+
+        void bindRow(std::size_t slot, std::size_t row);
+
+        void cropCells();
+
+    public:
+        Table(GUIPos x,
+              GUIPos y,
+              std::vector<int> columnWidths,
+              std::size_t rowCount,
+              unsigned int visibleRows,
+              PinGUI::tableFuncPointer cellFunction,
+              clipboardData data,
+              std::vector<std::shared_ptr<GUI_Element>>* ELEMENTS,
+              bool* update);
+
+        ~Table();
+
+        //Number of data rows changed - the visible rows are bound again
+        void setRowCount(std::size_t rowCount);
+
+        //Data of the visible rows changed
+        void refreshRows();
+
+        std::size_t getRowCount();
+
+        void onAim() override;
+
+        void onEndAim() override;
+
+        void setShow(bool state) override;
+
+        void setExist(bool state) override;
+
+        void moveElement(const PinGUI::Vector2<GUIPos>& vect) override;
+
+        void cropElement(PinGUI::Rect& rect) override;
+
+        elementType getElementType() override;
+};
+
+#endif // TABLE_H
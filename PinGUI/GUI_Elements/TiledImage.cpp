@@ -0,0 +1,444 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "TiledImage.h"
+
+#include <cmath>
+#include <algorithm>
+
+TiledImage::TiledImage(SDL_Surface* source, GUIPos x, GUIPos y, int width, int height):
+    _viewRect(x,y,width,height),
+    _clipRect(x,y,width,height),
+    _viewX(0.0f),
+    _viewY(0.0f),
+    _zoom(1.0f),
+    _memoryBudget(PINGUI_TILE_BUDGET),
+    _residentBytes(0),
+    _frame(0),
+    _uploads(0),
+    _dirty(true)
+{
+    _position.x = x;
+    _position.y = y;
+
+    //Background for the parts outside of the image and the tiles still streaming in
+    addSprite(x,y,SheetManager::createRectangle(width,height,BOARD,BORDER_LINE));
+
+    _collidable = false;
+
+    buildLevels(source);
+
+    //Level is picked so a tile never spans less than half of its size on the screen
+    int tilesX = width / (PINGUI_TILE_SIZE / 2) + 2;
+    int tilesY = height / (PINGUI_TILE_SIZE / 2) + 2;
+
+    _vboManager = std::make_unique<VBO_Manager>(tilesX * tilesY,true);
+}
+
+TiledImage::~TiledImage()
+{
+    for (auto& tile : _TILES)
+        PinGUI::GL_StateManager::deleteTexture(tile.second.texture);
+
+    for (std::size_t i = 0; i < _LEVELS.size(); i++)
+        SDL_FreeSurface(_LEVELS[i]);
+}
+
+void TiledImage::buildLevels(SDL_Surface* source){
+
+    //Tiles are uploaded straight from the surface, so it has to be in the GL byte order
+    if (source->format->format != SDL_PIXELFORMAT_RGBA32){
+
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(source,SDL_PIXELFORMAT_RGBA32,0);
+
+        SDL_FreeSurface(source);
+        source = converted;
+
+        if (!source)
+            ErrorManager::systemError("Cannot convert the tiled image!");
+    }
+
+    _LEVELS.push_back(source);
+
+    while (_LEVELS.back()->w > PINGUI_TILE_SIZE || _LEVELS.back()->h > PINGUI_TILE_SIZE)
+        _LEVELS.push_back(halveSurface(_LEVELS.back()));
+}
+
+SDL_Surface* TiledImage::halveSurface(SDL_Surface* source){
+
+    int width = std::max(1,source->w / 2);
+    int height = std::max(1,source->h / 2);
+
+    SDL_Surface* result = SDL_CreateRGBSurfaceWithFormat(0,width,height,32,SDL_PIXELFORMAT_RGBA32);
+
+    if (!result)
+        ErrorManager::systemError("Cannot create a level of the tiled image!");
+
+    const Uint8* src = static_cast<const Uint8*>(source->pixels);
+    Uint8* dst = static_cast<Uint8*>(result->pixels);
+
+    //Average of 2x2 source pixels
+    for (int y = 0; y < height; y++){
+
+        const Uint8* row0 = src + std::min(y * 2,source->h - 1) * source->pitch;
+        const Uint8* row1 = src + std::min(y * 2 + 1,source->h - 1) * source->pitch;
+
+        Uint8* target = dst + y * result->pitch;
+
+        for (int x = 0; x < width; x++){
+
+            int x0 = std::min(x * 2,source->w - 1) * 4;
+            int x1 = std::min(x * 2 + 1,source->w - 1) * 4;
+
+            for (int c = 0; c < 4; c++)
+                target[x * 4 + c] = Uint8((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) / 4);
+        }
+    }
+
+    return result;
+}
+
+uint64_t TiledImage::getTileKey(int level, int tileX, int tileY){
+    return (uint64_t(level) << 48) | (uint64_t(tileY) << 24) | uint64_t(tileX);
+}
+
+int TiledImage::getLevelTilesX(int level){
+    return (_LEVELS[level]->w + PINGUI_TILE_SIZE - 1) / PINGUI_TILE_SIZE;
+}
+
+int TiledImage::getLevelTilesY(int level){
+    return (_LEVELS[level]->h + PINGUI_TILE_SIZE - 1) / PINGUI_TILE_SIZE;
+}
+
+imageTile* TiledImage::getTile(int level, int tileX, int tileY, bool upload){
+
+    uint64_t key = getTileKey(level,tileX,tileY);
+
+    auto it = _TILES.find(key);
+
+    if (it != _TILES.end()){
+
+        it->second.lastUsed = _frame;
+        return &it->second;
+    }
+
+    if (!upload)
+        return nullptr;
+
+    SDL_Surface* surface = _LEVELS[level];
+
+    imageTile tile;
+    tile.width = std::min(PINGUI_TILE_SIZE,surface->w - tileX * PINGUI_TILE_SIZE);
+    tile.height = std::min(PINGUI_TILE_SIZE,surface->h - tileY * PINGUI_TILE_SIZE);
+    tile.lastUsed = _frame;
+
+    std::size_t bytes = std::size_t(tile.width) * std::size_t(tile.height) * 4;
+
+    if (!makeRoom(bytes))
+        return nullptr;
+
+    glGenTextures(1,&tile.texture);
+
+    if (tile.texture==0)
+        ErrorManager::systemError("Cannot generate tile texture!");
+
+    PinGUI::GL_StateManager::bindTexture(tile.texture);
+
+    //Tile is read straight out of the level surface
+    glPixelStorei(GL_UNPACK_ALIGNMENT,4);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH,surface->pitch / 4);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS,tileX * PINGUI_TILE_SIZE);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS,tileY * PINGUI_TILE_SIZE);
+
+    glTexImage2D(GL_TEXTURE_2D,0,GL_RGBA8,tile.width,tile.height,0,GL_RGBA,GL_UNSIGNED_BYTE,surface->pixels);
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH,0);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS,0);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS,0);
+
+    //Wrapping - neighbour tiles must not bleed in
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_CLAMP_TO_EDGE);
+
+    //Filtering - the level is never minified more than twice
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+
+    PinGUI::GL_StateManager::bindTexture(0);
+
+    _residentBytes += bytes;
+    _uploads++;
+
+    return &(_TILES[key] = tile);
+}
+
+bool TiledImage::makeRoom(std::size_t bytes){
+
+    while (_residentBytes + bytes > _memoryBudget && !_TILES.empty()){
+
+        auto oldest = _TILES.end();
+
+        for (auto it = _TILES.begin(); it != _TILES.end(); it++){
+
+            if (oldest == _TILES.end() || it->second.lastUsed < oldest->second.lastUsed)
+                oldest = it;
+        }
+
+        //Everything left is drawn in this frame
+        if (oldest->second.lastUsed >= _frame)
+            return false;
+
+        _residentBytes -= std::size_t(oldest->second.width) * std::size_t(oldest->second.height) * 4;
+
+        PinGUI::GL_StateManager::deleteTexture(oldest->second.texture);
+        _TILES.erase(oldest);
+    }
+
+    return _residentBytes + bytes <= _memoryBudget;
+}
+
+void TiledImage::addQuad(float left, float top, float right, float bottom,
+                         float u0, float v0, float u1, float v1, GLuint texture){
+
+    if (right <= left || top <= bottom)
+        return;
+
+    float clipLeft = std::max(left,_clipRect.x);
+    float clipRight = std::min(right,_clipRect.x + _clipRect.w);
+    float clipBottom = std::max(bottom,_clipRect.y);
+    float clipTop = std::min(top,_clipRect.y + _clipRect.h);
+
+    if (clipRight <= clipLeft || clipTop <= clipBottom)
+        return;
+
+    //Texture coords of the cropped corners
+    float uLeft = u0 + (clipLeft - left) / (right - left) * (u1 - u0);
+    float uRight = u0 + (clipRight - left) / (right - left) * (u1 - u0);
+    float vTop = v0 + (top - clipTop) / (top - bottom) * (v1 - v0);
+    float vBottom = v0 + (top - clipBottom) / (top - bottom) * (v1 - v0);
+
+    vboData quad;
+
+    quad.vertices[0].setPosition(clipRight,clipTop);
+    quad.vertices[0].setUV(uRight,vTop);
+
+    quad.vertices[1].setPosition(clipLeft,clipTop);
+    quad.vertices[1].setUV(uLeft,vTop);
+
+    quad.vertices[2].setPosition(clipLeft,clipBottom);
+    quad.vertices[2].setUV(uLeft,vBottom);
+
+    quad.vertices[3].setPosition(clipRight,clipBottom);
+    quad.vertices[3].setUV(uRight,vBottom);
+
+    for (int i = 0; i < PINGUI_QUAD_VERTICES; i++)
+        quad.vertices[i].setColor(255,255,255,255);
+
+    _QUADS.push_back(quad);
+    _QUAD_TEXTURES.push_back(texture);
+}
+
+void TiledImage::buildQuads(){
+
+    _frame++;
+    _dirty = false;
+
+    _QUADS.clear();
+    _QUAD_TEXTURES.clear();
+
+    if (_LEVELS.empty() || _zoom <= 0.0f || _clipRect.w <= 0 || _clipRect.h <= 0)
+        return;
+
+    //Finest level that still isn't minified more than twice
+    int level = 0;
+
+    while (level + 1 < int(_LEVELS.size()) && float(1 << (level + 1)) <= 1.0f / _zoom)
+        level++;
+
+    float levelScale = float(1 << level);
+    float tileSpan = PINGUI_TILE_SIZE * levelScale;
+
+    float viewTop = _viewRect.y + _viewRect.h;
+
+    //Source pixels inside of the clip rect
+    float sourceLeft = _viewX + (_clipRect.x - _viewRect.x) / _zoom;
+    float sourceRight = _viewX + (_clipRect.x + _clipRect.w - _viewRect.x) / _zoom;
+    float sourceTop = _viewY + (viewTop - (_clipRect.y + _clipRect.h)) / _zoom;
+    float sourceBottom = _viewY + (viewTop - _clipRect.y) / _zoom;
+
+    int firstX = std::max(0,int(std::floor(sourceLeft / tileSpan)));
+    int lastX = std::min(getLevelTilesX(level),int(std::ceil(sourceRight / tileSpan)));
+    int firstY = std::max(0,int(std::floor(sourceTop / tileSpan)));
+    int lastY = std::min(getLevelTilesY(level),int(std::ceil(sourceBottom / tileSpan)));
+
+    SDL_Surface* surface = _LEVELS[level];
+
+    uint64_t firstUpload = _uploads;
+
+    for (int tileY = firstY; tileY < lastY; tileY++){
+
+        for (int tileX = firstX; tileX < lastX; tileX++){
+
+            int width = std::min(PINGUI_TILE_SIZE,surface->w - tileX * PINGUI_TILE_SIZE);
+            int height = std::min(PINGUI_TILE_SIZE,surface->h - tileY * PINGUI_TILE_SIZE);
+
+            float left = _viewRect.x + (tileX * tileSpan - _viewX) * _zoom;
+            float right = left + width * levelScale * _zoom;
+            float top = viewTop - (tileY * tileSpan - _viewY) * _zoom;
+            float bottom = top - height * levelScale * _zoom;
+
+            bool canUpload = (_uploads - firstUpload) < PINGUI_TILE_UPLOADS_PER_FRAME;
+
+            imageTile* tile = getTile(level,tileX,tileY,canUpload);
+
+            if (tile){
+
+                addQuad(left,top,right,bottom,0.0f,1.0f,1.0f,0.0f,tile->texture);
+                continue;
+            }
+
+            //Streamed in one of the next frames, till then a coarser tile stands in
+            _dirty = true;
+
+            for (int parent = level + 1; parent < int(_LEVELS.size()); parent++){
+
+                int shift = parent - level;
+
+                imageTile* parentTile = getTile(parent,tileX >> shift,tileY >> shift,false);
+
+                if (!parentTile)
+                    continue;
+
+                float scale = float(1 << shift);
+
+                //Position of this tile inside of the parent tile, in the parent pixels
+                float x = (tileX * PINGUI_TILE_SIZE) / scale - (tileX >> shift) * PINGUI_TILE_SIZE;
+                float y = (tileY * PINGUI_TILE_SIZE) / scale - (tileY >> shift) * PINGUI_TILE_SIZE;
+
+                addQuad(left,top,right,bottom,
+                        x / parentTile->width,
+                        1.0f - y / parentTile->height,
+                        (x + width / scale) / parentTile->width,
+                        1.0f - (y + height / scale) / parentTile->height,
+                        parentTile->texture);
+                break;
+            }
+        }
+    }
+
+    _vboManager->bufferData(0,_QUADS);
+}
+
+void TiledImage::setView(float sourceX, float sourceY, float zoom){
+
+    _viewX = sourceX;
+    _viewY = sourceY;
+    _zoom = zoom;
+
+    _dirty = true;
+}
+
+void TiledImage::setMemoryBudget(std::size_t bytes){
+
+    _memoryBudget = bytes;
+
+    //Tiles of the last drawn frame are kept till the next one
+    _frame++;
+    makeRoom(0);
+
+    _dirty = true;
+}
+
+void TiledImage::draw(int& pos){
+
+    //Background
+    GUI_Element::draw(pos);
+
+    if (!_show)
+        return;
+
+    if (_dirty)
+        buildQuads();
+
+    if (_QUADS.empty())
+        return;
+
+    //Drawn in the middle of the GUIManager's quads, its VAO and draw base are bound back after
+    VBO_Manager::boundState previous = VBO_Manager::getBound();
+
+    _vboManager->bind();
+
+    //Neighbouring tiles of the same texture go in one draw
+    for (std::size_t i = 0; i < _QUADS.size();){
+
+        std::size_t end = i + 1;
+
+        while (end < _QUADS.size() && _QUAD_TEXTURES[end] == _QUAD_TEXTURES[i])
+            end++;
+
+        PinGUI::GL_StateManager::bindTexture(_QUAD_TEXTURES[i]);
+        VBO_Manager::drawQuads(int(i),int(end - i));
+
+        i = end;
+    }
+
+    VBO_Manager::restoreBound(previous);
+}
+
+bool TiledImage::needRedraw(){
+    return _dirty;
+}
+
+void TiledImage::moveElement(const PinGUI::Vector2<GUIPos>& vect){
+
+    GUI_Element::moveElement(vect);
+
+    _viewRect.addPos(vect);
+    _clipRect.addPos(vect);
+
+    _dirty = true;
+}
+
+void TiledImage::cropElement(PinGUI::Rect& rect){
+
+    GUI_Element::cropElement(rect);
+
+    float left = std::max(_viewRect.x,rect.x);
+    float bottom = std::max(_viewRect.y,rect.y);
+    float right = std::min(_viewRect.x + _viewRect.w,rect.x + rect.w);
+    float top = std::min(_viewRect.y + _viewRect.h,rect.y + rect.h);
+
+    _clipRect = PinGUI::Rect(left,bottom,std::max(0,int(right - left)),std::max(0,int(top - bottom)));
+
+    _dirty = true;
+}
+
+int TiledImage::getImageWidth(){
+    return _LEVELS.empty() ? 0 : _LEVELS[0]->w;
+}
+
+int TiledImage::getImageHeight(){
+    return _LEVELS.empty() ? 0 : _LEVELS[0]->h;
+}
@@ -0,0 +1,151 @@
+#ifndef TILEDIMAGE_H
+#define TILEDIMAGE_H
+
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+#include "../GUI_Element.h"
+#include "../VBO_Manager.h"
+
+//Width and height of one tile in pixels
+#define PINGUI_TILE_SIZE 256
+
+//Default texture memory of one tiled image
+#define PINGUI_TILE_BUDGET (64 * 1024 * 1024)
+
+//New tiles uploaded in one frame, the rest is streamed in the next frames
+#define PINGUI_TILE_UPLOADS_PER_FRAME 4
+
+struct imageTile{
+
+    GLuint texture = 0;
+    int width = 0;
+    int height = 0;
+
+    //Frame the tile was drawn in the last time
+    uint64_t lastUsed = 0;
+};
+
+/**
+    Viewer of images too big for one texture
+    The image is kept as a pyramid of halved surfaces, only the tiles of the level matching the zoom
+    that are visible inside the crop rect get uploaded, the least recently used ones are evicted
+    when the texture memory goes over the budget
+**/
+class TiledImage: public GUI_Element
+{
+    private:
+
+        //Level 0 is the source image, every next one has half of the size
+        std::vector<SDL_Surface*> _LEVELS;
+
+        std::unordered_map<uint64_t,imageTile> _TILES;
+
+        std::vector<vboData> _QUADS;
+
+        std::vector<GLuint> _QUAD_TEXTURES;
+
+        std::unique_ptr<VBO_Manager> _vboManager;
+
+        PinGUI::Rect _viewRect;
+
+        //Part of the view inside of the crop rect
+        PinGUI::Rect _clipRect;
+
+        //Source pixel at the top left corner of the view
+        float _viewX;
+
+        float _viewY;
+
+        //Screen pixels per source pixel
+        float _zoom;
+
+        std::size_t _memoryBudget;
+
+        std::size_t _residentBytes;
+
+        uint64_t _frame;
+
+        uint64_t _uploads;
+
+        //Quads have to be rebuilt - view changed or some tiles are still missing
+        bool _dirty;
+
+        /**
+            Private methods
+        **/
+        void buildLevels(SDL_Surface* source);
+
+        static SDL_Surface* halveSurface(SDL_Surface* source);
+
+        static uint64_t getTileKey(int level, int tileX, int tileY);
+
+        int getLevelTilesX(int level);
+
+        int getLevelTilesY(int level);
+
+        //Resident tile or nullptr, with upload allowed it is uploaded if the budget lets it
+        imageTile* getTile(int level, int tileX, int tileY, bool upload);
+
+        bool makeRoom(std::size_t bytes);
+
+        void buildQuads();
+
+        //Screen rect with the texture coords of its corners, cropped to the clip rect
+        void addQuad(float left, float top, float right, float bottom,
+                     float u0, float v0, float u1, float v1, GLuint texture);
+
+    public:
+        //The image takes the surface over
+        TiledImage(SDL_Surface* source, GUIPos x, GUIPos y, int width, int height);
+        ~TiledImage();
+
+        //Pan and zoom, position is in the source pixels
+        void setView(float sourceX, float sourceY, float zoom);
+
+        void setMemoryBudget(std::size_t bytes);
+
+        void draw(int& pos) override;
+
+        bool needRedraw() override;
+
+        void moveElement(const PinGUI::Vector2<GUIPos>& vect) override;
+
+        void cropElement(PinGUI::Rect& rect) override;
+
+        int getImageWidth();
+
+        int getImageHeight();
+
+        std::size_t getResidentBytes(){return _residentBytes;}
+
+        uint64_t getTileUploads(){return _uploads;}
+};
+
+#endif // TILEDIMAGE_H
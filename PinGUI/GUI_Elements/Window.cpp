@@ -23,6 +23,9 @@ misrepresented as being the original software.
 **/
 
 #include "Window.h"
+#include "../Shader_Program.h"
+
+#include <algorithm>
 
 Window::Window(windowDef* winDef) :
 	_mainFrame(winDef->windowFrame),
@@ -43,7 +46,10 @@ Window::Window(windowDef* winDef) :
 	_mainWindowPtr(nullptr),
 	_windowTitleText(nullptr),
 	_shape(winDef->shape),
-	_windowTitle(BLANK)
+	_windowTitle(BLANK),
+	_cacheDamaged(true),
+	_cacheRevision(0),
+	_cachedTabGUI(nullptr)
 {
 	initPosition(_mainFrame);
 
@@ -192,6 +198,18 @@ std::shared_ptr<WindowTab> Window::getTab(std::string tabName) {
 
 void Window::render() {
 
+	if (_renderCache)
+		renderCached();
+	else
+		renderWindow();
+
+	//Attached windows have their own caches
+	for (std::size_t i = 0; i < _attachedWindows.size(); i++)
+		_attachedWindows[i]->render();
+}
+
+void Window::renderWindow() {
+
 	_mainGUIManager->render();
 
 	//Also the opened tab need to be rendered
@@ -199,9 +217,153 @@ void Window::render() {
 
 		_mainWindowTab->getGUI()->render();
 	}
+}
+
+void Window::enableRenderCache(bool state) {
+
+	if (state && !_renderCache) {
+
+		_renderCache = std::make_unique<PinGUI::RenderTarget>();
+		_cacheQuadVBO = std::make_unique<VBO_Manager>(1, true);
+		_cacheQuad.resize(1);
+		_cacheDamaged = true;
+
+	} else if (!state) {
+
+		_renderCache.reset();
+		_cacheQuadVBO.reset();
+		_cacheQuad.clear();
+	}
+}
+
+bool Window::isRenderCacheEnabled() {
+	return _renderCache != nullptr;
+}
+
+void Window::invalidateRenderCache() {
+	_cacheDamaged = true;
+}
+
+bool Window::isCacheDamaged() {
+
+	_mainGUIManager->refresh();
+
+	uint64_t revision = _mainGUIManager->getRevision();
+	GUIManager* tabGUI = nullptr;
+
+	if (_mainWindowTab) {
+
+		tabGUI = _mainWindowTab->getGUI().get();
+		tabGUI->refresh();
+		revision += tabGUI->getRevision();
+	}
+
+	if (!_cacheDamaged && revision == _cacheRevision && tabGUI == _cachedTabGUI)
+		return false;
+
+	_cacheRevision = revision;
+	_cachedTabGUI = tabGUI;
+
+	return true;
+}
+
+void Window::renderCached() {
+
+	if (isCacheDamaged())
+		updateCache();
+
+	//Framebuffer isn't available - drawing directly
+	if (!_renderCache->isValid()) {
+
+		renderWindow();
+		return;
+	}
+
+	GLint previousBlend[4];
+	PinGUI::beginPremultipliedBlend(previousBlend);
+
+	_cacheQuadVBO->bind();
+	PinGUI::GL_StateManager::bindTexture(_renderCache->getTexture());
+
+	VBO_Manager::drawQuads(0);
+
+	PinGUI::GL_StateManager::bindVertexArray(0);
+
+	PinGUI::endPremultipliedBlend(previousBlend);
+}
+
+void Window::updateCache() {
+
+	//Vertex data used for the bounds are already uploaded by the refresh
+	if (!_mainGUIManager->getBounds(_cacheRect) || !_renderCache->resize(_cacheRect.w, _cacheRect.h)) {
+
+		_cacheDamaged = true;
+		return;
+	}
+
+	_renderCache->begin();
+
+	PinGUI::Shader_Program::setProjection(glm::ortho(_cacheRect.x, _cacheRect.x + _cacheRect.w, _cacheRect.y, _cacheRect.y + _cacheRect.h));
+
+	renderWindow();
+
+	PinGUI::Shader_Program::setProjection(PinGUI::CameraManager::getCameraMatrix());
+
+	_renderCache->end();
+
+	_renderCache->fillQuad(_cacheQuad[0], _cacheRect);
+	_cacheQuadVBO->bufferData(0, _cacheQuad);
+
+	_cacheDamaged = false;
+}
+
+void Window::collectGUIManagers(std::vector<GUIManager*>& managers) {
+
+	managers.push_back(_mainGUIManager.get());
+
+	if (_mainWindowTab) {
+
+		managers.push_back(_mainWindowTab->getGUI().get());
+	}
 
 	for (std::size_t i = 0; i < _attachedWindows.size(); i++)
-		_attachedWindows[i]->render();
+		_attachedWindows[i]->collectGUIManagers(managers);
+}
+
+bool Window::getBounds(PinGUI::Rect& bounds) {
+
+	bool found = false;
+	PinGUI::Rect part;
+
+	auto addPart = [&](bool hasPart) {
+
+		if (!hasPart)
+			return;
+
+		if (!found) {
+
+			bounds = part;
+			found = true;
+			return;
+		}
+
+		float left = std::min(bounds.x, part.x);
+		float bottom = std::min(bounds.y, part.y);
+		float right = std::max(bounds.x + bounds.w, part.x + part.w);
+		float top = std::max(bounds.y + bounds.h, part.y + part.h);
+
+		bounds = PinGUI::Rect(left, bottom, int(right - left), int(top - bottom));
+	};
+
+	addPart(_mainGUIManager->getBounds(part));
+
+	if (_mainWindowTab)
+		addPart(_mainWindowTab->getGUI()->getBounds(part));
+
+	for (std::size_t i = 0; i < _attachedWindows.size(); i++)
+		addPart(_attachedWindows[i]->getBounds(part));
+
+	return found;
 }
 
 void Window::update(bool allowCollision) {
@@ -820,9 +982,11 @@ const std::string& Window::getNameTag() const {
 
 void Window::setAlpha(Uint8 a) {
 
-	//Some additional settings as well
-
 	GUI_Element::setAlpha(a);
+
+	//Content of the tabs fades with the window
+	for (std::size_t i = 0; i < _TABS.size(); i++)
+		_TABS[i]->windowTab->getGUI()->setAlpha(a);
 }
 
 void Window::setWindowTitle(const std::string& newTitle) {
@@ -40,6 +40,8 @@
 #include "../GUI_Elements/HorizontalScroller.h"
 #include "../GUI_Elements/VerticalScroller.h"
 #include "../CropManager.hpp"
+#include "../RenderTarget.h"
+#include "../VBO_Manager.h"
 
 /** MANIPULATION WITH WINDOW TABS **/
 #define WINDOW_TAB_FONT_SIZE 14
@@ -181,6 +183,22 @@ class Window: public GUI_Element
 
 		bool _alreadyMovedTo;
 
+        //Render cache - the window is drawn into the target only when it changed
+        std::unique_ptr<PinGUI::RenderTarget> _renderCache;
+
+        std::unique_ptr<VBO_Manager> _cacheQuadVBO;
+
+        std::vector<vboData> _cacheQuad;
+
+        PinGUI::Rect _cacheRect;
+
+        bool _cacheDamaged;
+
+        //Revision of the GUIManagers drawn into the cache
+        uint64_t _cacheRevision;
+
+        GUIManager* _cachedTabGUI;
+
         //Moving vector
         PinGUI::Vector2<GUIPos> _movingVect;
 
@@ -233,6 +251,14 @@ class Window: public GUI_Element
 
 	   bool checkWindowRect();
 
+	   bool isCacheDamaged();
+
+	   void renderWindow();
+
+	   void renderCached();
+
+	   void updateCache();
+
     public:
         Window(){};
         Window(windowDef* winDef);
@@ -261,6 +287,20 @@ class Window: public GUI_Element
 
         void render();
 
+        //Opt-in caching - the window is rendered into a texture only when it changed, otherwise it's one quad
+        void enableRenderCache(bool state);
+
+        bool isRenderCacheEnabled();
+
+        //Forces a redraw of the cache in the next frame
+        void invalidateRenderCache();
+
+        //GUIManagers in the same order as render() uses them
+        void collectGUIManagers(std::vector<GUIManager*>& managers);
+
+        //Rectangle covered by render(), attached windows included - false when there is nothing to draw
+        bool getBounds(PinGUI::Rect& bounds);
+
         void update(bool allowCollision = true);
 
         void moveWindow(PinGUI::Vector2<GUIPos> vect);
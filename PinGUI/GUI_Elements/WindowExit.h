@@ -49,6 +49,8 @@ class WindowExit: public GUI_Element
 
         void info() override;
 
+        bool canDeferMove() override { return true; }
+
 };
 
 #endif // WINDOWEXIT_H
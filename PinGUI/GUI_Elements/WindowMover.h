@@ -56,6 +56,8 @@ public:
 
         void info() override;
 
+        bool canDeferMove() override { return true; }
+
         void modifyWindow();
 };
 
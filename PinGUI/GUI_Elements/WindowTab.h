@@ -80,6 +80,8 @@ class WindowTab: public GUI_Element
 
         void info() override;
 
+        bool canDeferMove() override { return true; }
+
         void setMainTab(std::shared_ptr<WindowTab>* mainTab );
 
         void setTabText(std::shared_ptr<Text> text);
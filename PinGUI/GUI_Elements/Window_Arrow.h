@@ -68,6 +68,8 @@ class Window_Arrow: public GUI_Element
 
         void onClick() override;
 
+        bool canDeferMove() override { return true; }
+
         void setClickFunction(PinGUI::basicPointer method);
 
 };
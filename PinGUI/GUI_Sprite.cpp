@@ -24,9 +24,16 @@
 
 #include "GUI_Sprite.h"
 #include <iostream>
+#include <algorithm>
 
 GUI_Sprite::GUI_Sprite(PinGUI::Rect rect, SDL_Surface* source,SDL_Color color):
-    _textureID(0)
+    _textureID(0),
+    _textureWidth(0),
+    _firstGlyph(0),
+    _glyphRight(0),
+    _uMin(0.0f),
+    _uMax(1.0f),
+    _ownTexture(true)
 {
     _rect.rect.initPos(rect);
 
@@ -41,7 +48,13 @@ GUI_Sprite::GUI_Sprite(PinGUI::Rect rect, SDL_Surface* source,SDL_Color color):
 }
 
 GUI_Sprite::GUI_Sprite(PinGUI::Rect rect,SDL_Surface* source):
-    _textureID(0)
+    _textureID(0),
+    _textureWidth(0),
+    _firstGlyph(0),
+    _glyphRight(0),
+    _uMin(0.0f),
+    _uMax(1.0f),
+    _ownTexture(true)
 {
     _rect.rect.initPos(rect);
 
@@ -52,7 +65,13 @@ GUI_Sprite::GUI_Sprite(PinGUI::Rect rect,SDL_Surface* source):
 }
 
 GUI_Sprite::GUI_Sprite(PinGUI::Vector2<GUIPos> pos, SDL_Surface* source):
-    _textureID(0)
+    _textureID(0),
+    _textureWidth(0),
+    _firstGlyph(0),
+    _glyphRight(0),
+    _uMin(0.0f),
+    _uMax(1.0f),
+    _ownTexture(true)
 {
     _rect.rect.initPos(pos);
 
@@ -63,7 +82,13 @@ GUI_Sprite::GUI_Sprite(PinGUI::Vector2<GUIPos> pos, SDL_Surface* source):
 }
 
 GUI_Sprite::GUI_Sprite(const std::string& text, PinGUI::Vector2<GUIPos> pos,textInfo* info):
-    _textureID(0)
+    _textureID(0),
+    _textureWidth(0),
+    _firstGlyph(0),
+    _glyphRight(0),
+    _uMin(0.0f),
+    _uMax(1.0f),
+    _ownTexture(true)
 {
     _rect.rect.initPos(pos);
 
@@ -73,7 +98,13 @@ GUI_Sprite::GUI_Sprite(const std::string& text, PinGUI::Vector2<GUIPos> pos,text
 }
 
 GUI_Sprite::GUI_Sprite(const std::string& text,textInfo* info):
-    _textureID(0)
+    _textureID(0),
+    _textureWidth(0),
+    _firstGlyph(0),
+    _glyphRight(0),
+    _uMin(0.0f),
+    _uMax(1.0f),
+    _ownTexture(true)
 {
     _rect.rect.x = 0;
     _rect.rect.y = 0;
@@ -97,9 +128,36 @@ void GUI_Sprite::loadTextSprite(const std::string& text, textInfo*& info){
     createTexture(tmpSurface);
 }
 
+GUI_Sprite::GUI_Sprite(PinGUI::Rect rect, GLuint atlasTexture, float uMin, float uMax):
+    _textureID(atlasTexture),
+    _textureWidth(0),
+    _firstGlyph(0),
+    _glyphRight(0),
+    _uMin(uMin),
+    _uMax(uMax),
+    _ownTexture(false)
+{
+    initColor();
+
+    _rect.rect = rect;
+    _rect.realRect = rect;
+
+    createVBO();
+}
+
 GUI_Sprite::~GUI_Sprite()
 {
-    glDeleteTextures(1,&_textureID);
+    releaseTexture();
+}
+
+void GUI_Sprite::releaseTexture(){
+
+    if (_ownTexture)
+        PinGUI::GL_StateManager::deleteTexture(_textureID);
+    else
+        _textureID = 0;
+
+    _ownTexture = true;
 }
 
 
@@ -114,12 +172,14 @@ void GUI_Sprite::initColor(){
 
 void GUI_Sprite::createTexture(SDL_Surface* surface){
 
+    _ownTexture = true;
+
     glGenTextures(1,&_textureID);
 
     if (_textureID==0)
         ErrorManager::systemError("Cannot generate GUI texture!");
 
-    glBindTexture(GL_TEXTURE_2D,_textureID);
+    PinGUI::GL_StateManager::bindTexture(_textureID);
 
     int Mode = GL_RGB;
 
@@ -130,6 +190,14 @@ void GUI_Sprite::createTexture(SDL_Surface* surface){
 
     glTexImage2D(GL_TEXTURE_2D,0,Mode,surface->w,surface->h,0,Mode,GL_UNSIGNED_BYTE,surface->pixels);
 
+    //Whole texture is shown
+    _GLYPHS.clear();
+    _GLYPH_ENDS.clear();
+    _textureWidth = 0;
+    _firstGlyph = 0;
+    _uMin = 0.0f;
+    _uMax = 1.0f;
+
     //Wrapping
     glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_S,GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_REPEAT);
@@ -138,7 +206,7 @@ void GUI_Sprite::createTexture(SDL_Surface* surface){
     glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_NEAREST);
 
-    glBindTexture(GL_TEXTURE_2D,0);
+    PinGUI::GL_StateManager::bindTexture(0);
     _rect.rect.w = surface->w;
     _rect.rect.h = surface->h;
 
@@ -148,10 +216,185 @@ void GUI_Sprite::createTexture(SDL_Surface* surface){
     _rect.realRect = _rect.rect;
 }
 
+void GUI_Sprite::rasterizeGlyphs(const std::string& text, textInfo* info, std::size_t first){
+
+    SDL_Surface* surface = TTF_RenderText_Blended(info->font,text.c_str(),info->color);
+
+    if (surface==nullptr){
+		std::cout << SDL_GetError() << std::endl;
+        ErrorManager::systemError("Cannot make a text texture");
+    }
+
+    releaseTexture();
+
+    glGenTextures(1,&_textureID);
+
+    if (_textureID==0)
+        ErrorManager::systemError("Cannot generate GUI texture!");
+
+    //Spare width, so typing at the end doesn't need a new texture
+    _textureWidth = std::max(surface->w * 2,PINGUI_GLYPH_MIN_CAPACITY);
+
+    PinGUI::GL_StateManager::bindTexture(_textureID);
+
+    glTexImage2D(GL_TEXTURE_2D,0,GL_RGBA,_textureWidth,surface->h,0,GL_RGBA,GL_UNSIGNED_BYTE,nullptr);
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH,surface->pitch / 4);
+    glTexSubImage2D(GL_TEXTURE_2D,0,0,0,surface->w,surface->h,GL_RGBA,GL_UNSIGNED_BYTE,surface->pixels);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH,0);
+
+    //Wrapping
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_CLAMP_TO_EDGE);
+
+    //Filtering
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_NEAREST);
+
+    PinGUI::GL_StateManager::bindTexture(0);
+
+    //Pen positions the same way SDL_ttf places the glyphs
+    _GLYPHS = text;
+    _GLYPH_ENDS.resize(text.size());
+
+    int pen = 0;
+
+    for (std::size_t i = 0; i < text.size(); i++){
+
+        int advance = 0;
+
+        if (i > 0)
+            pen += TTF_GetFontKerningSizeGlyphs(info->font,Uint16(text[i-1]),Uint16(text[i]));
+
+        TTF_GlyphMetrics(info->font,Uint16(text[i]),nullptr,nullptr,nullptr,nullptr,&advance);
+
+        pen += advance;
+        _GLYPH_ENDS[i] = pen;
+    }
+
+    _glyphRight = surface->w;
+    _firstGlyph = std::min(first,_GLYPHS.size());
+
+    _rect.realRect.h = surface->h;
+
+    SDL_FreeSurface(surface);
+
+    updateGlyphWindow();
+}
+
+bool GUI_Sprite::appendGlyph(char ch, textInfo* info){
+
+    if (!isGlyphEditable())
+        return false;
+
+    char glyph[2] = {ch,'\0'};
+
+    int pen = _GLYPH_ENDS.empty() ? 0 : _GLYPH_ENDS.back();
+
+    if (!_GLYPHS.empty())
+        pen += TTF_GetFontKerningSizeGlyphs(info->font,Uint16(_GLYPHS.back()),Uint16(ch));
+
+    int minX = 0, advance = 0;
+
+    TTF_GlyphMetrics(info->font,Uint16(ch),&minX,nullptr,nullptr,nullptr,&advance);
+
+    //Uploaded cell starts at the pen, so it can't take ink left of the pen
+    if (minX < 0)
+        return false;
+
+    //Ink of the previous glyph reaching past the pen (italics, negative kerning) would be cleared by the cell
+    if (!_GLYPHS.empty()){
+
+        int previousMaxX = 0, previousAdvance = 0;
+
+        TTF_GlyphMetrics(info->font,Uint16(_GLYPHS.back()),nullptr,&previousMaxX,nullptr,nullptr,&previousAdvance);
+
+        if (_GLYPH_ENDS.back() - previousAdvance + previousMaxX > pen)
+            return false;
+    }
+
+    SDL_Surface* surface = TTF_RenderText_Blended(info->font,glyph,info->color);
+
+    if (surface==nullptr)
+        return false;
+
+    if (pen < 0 || pen + surface->w > _textureWidth || surface->h != _rect.realRect.h){
+
+        SDL_FreeSurface(surface);
+        return false;
+    }
+
+    PinGUI::GL_StateManager::bindTexture(_textureID);
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH,surface->pitch / 4);
+    glTexSubImage2D(GL_TEXTURE_2D,0,pen,0,surface->w,surface->h,GL_RGBA,GL_UNSIGNED_BYTE,surface->pixels);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH,0);
+
+    PinGUI::GL_StateManager::bindTexture(0);
+
+    _GLYPHS.push_back(ch);
+    _GLYPH_ENDS.push_back(pen + advance);
+
+    _glyphRight = pen + surface->w;
+
+    SDL_FreeSurface(surface);
+
+    updateGlyphWindow();
+
+    return true;
+}
+
+void GUI_Sprite::truncateGlyphs(std::size_t count){
+
+    if (count >= _GLYPHS.size())
+        return;
+
+    _GLYPHS.resize(count);
+    _GLYPH_ENDS.resize(count);
+
+    //Pixels of the removed glyphs stay in the texture, they are just out of the shown part
+    _glyphRight = _GLYPH_ENDS.empty() ? 0 : _GLYPH_ENDS.back();
+    _firstGlyph = std::min(_firstGlyph,count);
+
+    updateGlyphWindow();
+}
+
+void GUI_Sprite::setAtlasRect(PinGUI::Rect rect, float uMin, float uMax){
+
+    _uMin = uMin;
+    _uMax = uMax;
+
+    _rect.rect = rect;
+    _rect.realRect = rect;
+
+    createVBO();
+}
+
+void GUI_Sprite::showGlyphsFrom(std::size_t first){
+
+    _firstGlyph = std::min(first,_GLYPHS.size());
+
+    updateGlyphWindow();
+}
+
+void GUI_Sprite::updateGlyphWindow(){
+
+    int left = _firstGlyph > 0 ? _GLYPH_ENDS[_firstGlyph-1] : 0;
+    int right = std::max(left,_glyphRight);
+
+    _uMin = float(left) / float(_textureWidth);
+    _uMax = float(right) / float(_textureWidth);
+
+    //Uncropped, the owner of the text crops it again after the change
+    _rect.realRect.w = right - left;
+    _rect.rect = _rect.realRect;
+
+    createVBO();
+}
+
 void GUI_Sprite::changeTexture(SDL_Surface* surface){
 
-    if (_textureID!=0)
-        glDeleteTextures(1,&_textureID);
+    releaseTexture();
 
     createTexture(surface);
 }
@@ -181,7 +424,7 @@ void GUI_Sprite::createVBO(VBO_UV_UPDATE_MODE mode){
 
 void GUI_Sprite::updateColors(){
 
-    for (int i = 0; i < 6; i++){
+    for (int i = 0; i < PINGUI_QUAD_VERTICES; i++){
 
         _dataPointer.vertices[i].setColor(_color.r,_color.g,_color.b,_color.a);
     }
@@ -192,34 +435,23 @@ void GUI_Sprite::updatePositions(){
     _dataPointer.vertices[0].setPosition(getX() + getW(), getY() + getH());
     _dataPointer.vertices[1].setPosition(getX(), getY() + getH());
     _dataPointer.vertices[2].setPosition(getX(),getY());
-    _dataPointer.vertices[3].setPosition(getX(),getY());
-    _dataPointer.vertices[4].setPosition(getX() + getW(), getY());
-    _dataPointer.vertices[5].setPosition(getX() + getW(), getY() + getH());
+    _dataPointer.vertices[3].setPosition(getX() + getW(), getY());
 
 }
 
 void GUI_Sprite::updateUVs(){
 
-    //1st triangle
     //Top right
-    _dataPointer.vertices[0].setUV(1.0f,1.0f);
+    _dataPointer.vertices[0].setUV(_uMax,1.0f);
 
     //Top left
-    _dataPointer.vertices[1].setUV(0.0f,1.0f);
-
-    //Bottom left
-    _dataPointer.vertices[2].setUV(0.0f,0.0f);
-
-    //2nd triangle
+    _dataPointer.vertices[1].setUV(_uMin,1.0f);
 
     //Bottom left
-    _dataPointer.vertices[3].setUV(0.0f,0.0f);
+    _dataPointer.vertices[2].setUV(_uMin,0.0f);
 
     //Bottom right
-    _dataPointer.vertices[4].setUV(1.0f,0.0f);
-
-    //Top right
-    _dataPointer.vertices[5].setUV(1.0f,1.0f);
+    _dataPointer.vertices[3].setUV(_uMax,0.0f);
 }
 
 
@@ -229,18 +461,14 @@ void GUI_Sprite::updateVerticalUVs(){
     _dataPointer.vertices[1].setV(1.0f);
     _dataPointer.vertices[2].setV(0.0f);
     _dataPointer.vertices[3].setV(0.0f);
-    _dataPointer.vertices[4].setV(0.0f);
-    _dataPointer.vertices[5].setV(1.0f);
 }
 
 void GUI_Sprite::updateHorizontalUVs(){
 
-    _dataPointer.vertices[0].setU(1.0f);
-    _dataPointer.vertices[1].setU(0.0f);
-    _dataPointer.vertices[2].setU(0.0f);
-    _dataPointer.vertices[3].setU(0.0f);
-    _dataPointer.vertices[4].setU(1.0f);
-    _dataPointer.vertices[5].setU(1.0f);
+    _dataPointer.vertices[0].setU(_uMax);
+    _dataPointer.vertices[1].setU(_uMin);
+    _dataPointer.vertices[2].setU(_uMin);
+    _dataPointer.vertices[3].setU(_uMax);
 }
 
 void GUI_Sprite::setX(float x){
@@ -33,9 +33,13 @@
 
 #include "ErrorManager.h"
 #include "stuff.h"
+#include "GL_StateManager.h"
 #include "PinGUI_Vector.hpp"
 #include "PinGUI_Rect.hpp"
 
+//Smallest width of the texture of an editable text
+#define PINGUI_GLYPH_MIN_CAPACITY 64
+
 typedef float GUIPos;
 
 enum vertexPoint{
@@ -63,10 +67,35 @@ class GUI_Sprite
 
         vboData _dataPointer;
 
+        //Editable text - glyphs in the texture and the pen position after every one of them
+        std::string _GLYPHS;
+
+        std::vector<int> _GLYPH_ENDS;
+
+        //Texture has spare width for appended glyphs, 0 for sprites that aren't editable
+        int _textureWidth;
+
+        //First shown glyph and the right edge of the last one
+        std::size_t _firstGlyph;
+
+        int _glyphRight;
+
+        //Shown part of the texture
+        float _uMin;
+
+        float _uMax;
+
+        //Sprites pointing into an atlas don't delete its texture
+        bool _ownTexture;
+
         /**
             Private methods
         **/
         void createTexture(SDL_Surface* surface);
+
+        void releaseTexture();
+
+        void updateGlyphWindow();
         void loadTextSprite(const std::string& text, textInfo*& info);
 
         void initColor();
@@ -81,6 +110,9 @@ class GUI_Sprite
         GUI_Sprite(const std::string& text, PinGUI::Vector2<GUIPos> pos,textInfo* info);
         GUI_Sprite(const std::string& text,textInfo* info);
 
+        /** Constructor for a part of a shared texture - the sprite doesn't own it **/
+        GUI_Sprite(PinGUI::Rect rect, GLuint atlasTexture, float uMin, float uMax);
+
         ~GUI_Sprite();
 
         void createVBO(VBO_UV_UPDATE_MODE mode = UV);
@@ -97,6 +129,30 @@ class GUI_Sprite
 
         void changeTexture(SDL_Surface* surface);
 
+        /** Editable text sprites - changes cost the edited glyphs, not the whole text **/
+
+        //Renders the whole text into a texture with spare width, shown from the glyph first
+        void rasterizeGlyphs(const std::string& text, textInfo* info, std::size_t first = 0);
+
+        //Renders one glyph after the last one, false when the texture is full or the glyphs overlap
+        bool appendGlyph(char ch, textInfo* info);
+
+        void truncateGlyphs(std::size_t count);
+
+        void showGlyphsFrom(std::size_t first);
+
+        bool isGlyphEditable(){return _textureWidth > 0;}
+
+        //Moves the sprite and its part of the shared texture, no texture work
+        void setAtlasRect(PinGUI::Rect rect, float uMin, float uMax);
+
+        std::size_t getGlyphCount(){return _GLYPHS.size();}
+
+        std::size_t getFirstGlyph(){return _firstGlyph;}
+
+        //Texture coord of the shown part at the percentage of its width
+        float getU(float percentage){return _uMin + percentage * (_uMax - _uMin);}
+
         void moveSprite(const PinGUI::Vector2<GUIPos>& vect);
 
         void offsetToRect(PinGUI::Rect offsetRect);
@@ -131,6 +187,9 @@ class GUI_Sprite
         void incW(int num);
 
         int getH(){return _rect.rect.h;}
+
+        //Cropped away completely, there is nothing to draw
+        bool isCulled(){return _rect.rect.w <= 0 || _rect.rect.h <= 0;}
         void setH(int newH);
         void decH(int num);
 
@@ -29,61 +29,91 @@
 
 namespace PinGUI{
 
-    std::unordered_map<unsigned int, bool> Input_Manager::_KEYS;
+    thread_local std::unordered_map<unsigned int, bool> Input_Manager::_KEYS;
 
-    gameState Input_Manager::_currentState = GAME;
+    thread_local gameState Input_Manager::_currentState = GAME;
 
-    SDL_Event Input_Manager::_mainEvent;
+    thread_local SDL_Event Input_Manager::_mainEvent;
 
-    inputState Input_Manager::_mainInputState = GAMEINPUT;
+    thread_local inputState Input_Manager::_mainInputState = GAMEINPUT;
 
-    int Input_Manager::_positionOfText = -1;
+    thread_local int Input_Manager::_positionOfText = -1;
 
-    std::shared_ptr<TextStorage> Input_Manager::_manipulatedText = nullptr;
+    thread_local std::shared_ptr<TextStorage> Input_Manager::_manipulatedText = nullptr;
 
-    std::shared_ptr<GUI_Sprite> Input_Manager::_manipulatedSprite = nullptr;
+    thread_local std::shared_ptr<GUI_Sprite> Input_Manager::_manipulatedSprite = nullptr;
 
-    bool* Input_Manager::_needUpdate = nullptr;
+    thread_local bool* Input_Manager::_needUpdate = nullptr;
 
-    bool Input_Manager::_alreadyClicked = false;
+    thread_local bool Input_Manager::_alreadyClicked = false;
 
-    bool Input_Manager::_singleClickTracker = false;
+    thread_local bool Input_Manager::_singleClickTracker = false;
 
-    bool Input_Manager::_allowWheel = false;
+    thread_local bool Input_Manager::_allowWheel = false;
 
-    bool Input_Manager::_haveTarget = false;
+    thread_local bool Input_Manager::_haveTarget = false;
 
-    bool Input_Manager::_tmpWheelInfo = false;
+    thread_local bool Input_Manager::_tmpWheelInfo = false;
 
-    bool Input_Manager::_isOnWindow = false;
+    thread_local bool Input_Manager::_isOnWindow = false;
 
-    manipulatingModInfo Input_Manager::_manipulatingModInfo;
+    thread_local manipulatingModInfo Input_Manager::_manipulatingModInfo;
 
-    int Input_Manager::_screenWidth;
+    thread_local int Input_Manager::_screenWidth;
 
-    int Input_Manager::_screenHeight;
+    thread_local int Input_Manager::_screenHeight;
 
-    writingModInfo Input_Manager::_writingModInfo;
+    thread_local writingModInfo Input_Manager::_writingModInfo;
 
-    PinGUI::Vector2<GUIPos> Input_Manager::_lastVector;
+    thread_local PinGUI::Vector2<GUIPos> Input_Manager::_lastVector;
 
-    wheelingInfo Input_Manager::_wheelingInfo;
+    thread_local wheelingInfo Input_Manager::_wheelingInfo;
 
-    PinGUI::basicPointer Input_Manager::_clFunction;
+    thread_local PinGUI::basicPointer Input_Manager::_clFunction;
 
-    PinGUI::basicPointer Input_Manager::_clickFunction;
+    thread_local PinGUI::basicPointer Input_Manager::_clickFunction;
 
-    PinGUI::Rect Input_Manager::_targetRect;
+    thread_local PinGUI::Rect Input_Manager::_targetRect;
 
-    bool Input_Manager::_tmpState = false;
+    thread_local bool Input_Manager::_tmpState = false;
 
-	Window* Input_Manager::_lastWindow = nullptr;
+	thread_local Window* Input_Manager::_lastWindow = nullptr;
 
     /**
         Storage for tmpWheel
     **/
 
-    static wheelingInfo infoStorage;
+    static thread_local wheelingInfo infoStorage;
+
+    void Input_Manager::swapContext(contextState& state){
+
+        std::swap(_KEYS,state.keys);
+        std::swap(_currentState,state.currentState);
+        std::swap(_mainEvent,state.mainEvent);
+        std::swap(_mainInputState,state.mainInputState);
+        std::swap(_manipulatedText,state.manipulatedText);
+        std::swap(_positionOfText,state.positionOfText);
+        std::swap(_writingModInfo,state.writingInfo);
+        std::swap(_manipulatingModInfo,state.manipulatingInfo);
+        std::swap(_manipulatedSprite,state.manipulatedSprite);
+        std::swap(_needUpdate,state.needUpdate);
+        std::swap(_alreadyClicked,state.alreadyClicked);
+        std::swap(_singleClickTracker,state.singleClickTracker);
+        std::swap(_allowWheel,state.allowWheel);
+        std::swap(_haveTarget,state.haveTarget);
+        std::swap(_isOnWindow,state.isOnWindow);
+        std::swap(_lastWindow,state.lastWindow);
+        std::swap(_tmpState,state.tmpState);
+        std::swap(_targetRect,state.targetRect);
+        std::swap(_lastVector,state.lastVector);
+        std::swap(_wheelingInfo,state.wheelInfo);
+        std::swap(infoStorage,state.tmpWheelStorage);
+        std::swap(_tmpWheelInfo,state.tmpWheelInfo);
+        std::swap(_clFunction,state.clFunction);
+        std::swap(_clickFunction,state.clickFunction);
+        std::swap(_screenWidth,state.screenWidth);
+        std::swap(_screenHeight,state.screenHeight);
+    }
 
     void Input_Manager::pressKey(unsigned int keyID){
         _KEYS[keyID] = true;
@@ -439,7 +469,11 @@ namespace PinGUI{
         return &_mainEvent;
     }
 
-    void Input_Manager::setWheeledInfo(std::shared_ptr<GUI_Sprite> sprite, bool* update, PinGUI::basicPointer f){
+    void Input_Manager::setWheeledInfo(const std::shared_ptr<GUI_Sprite>& sprite, bool* update, const PinGUI::basicPointer& f){
+
+        //Re-aiming the same scroller keeps the stored function, copying it would allocate
+        if (_wheelingInfo._wheeledSprite == sprite && _wheelingInfo._update == update)
+            return;
 
         _wheelingInfo._wheeledSprite = sprite;
         _wheelingInfo._update = update;
@@ -492,7 +526,7 @@ namespace PinGUI{
         return _allowWheel;
     }
 
-    wheelingInfo Input_Manager::getWheelInfo(){
+    const wheelingInfo& Input_Manager::getWheelInfo(){
         return _wheelingInfo;
     }
 
@@ -62,57 +62,89 @@ namespace PinGUI{
     {
         private:
 
-            static std::unordered_map<unsigned int, bool> _KEYS;
+            static thread_local std::unordered_map<unsigned int, bool> _KEYS;
 
-            static gameState _currentState;
+            static thread_local gameState _currentState;
 
-            static SDL_Event _mainEvent;
+            static thread_local SDL_Event _mainEvent;
 
-            static inputState _mainInputState;
+            static thread_local inputState _mainInputState;
 
             //Pointer to an text that is being changed by writing mod
-            static std::shared_ptr<TextStorage> _manipulatedText;
+            static thread_local std::shared_ptr<TextStorage> _manipulatedText;
 
-            static int _positionOfText;
+            static thread_local int _positionOfText;
 
-            static writingModInfo _writingModInfo;
+            static thread_local writingModInfo _writingModInfo;
 
-            static manipulatingModInfo _manipulatingModInfo;
+            static thread_local manipulatingModInfo _manipulatingModInfo;
 
-            static std::shared_ptr<GUI_Sprite> _manipulatedSprite;
+            static thread_local std::shared_ptr<GUI_Sprite> _manipulatedSprite;
 
-            static bool* _needUpdate;
+            static thread_local bool* _needUpdate;
 
-            static bool _alreadyClicked;
+            static thread_local bool _alreadyClicked;
 
-            static bool _singleClickTracker;
+            static thread_local bool _singleClickTracker;
 
-            static bool _allowWheel;
+            static thread_local bool _allowWheel;
 
-            static bool _haveTarget;
+            static thread_local bool _haveTarget;
 
-            static bool _isOnWindow;
+            static thread_local bool _isOnWindow;
 
-			static Window* _lastWindow;
+			static thread_local Window* _lastWindow;
 
-            static bool _tmpState;
+            static thread_local bool _tmpState;
 
-            static PinGUI::Rect _targetRect;
+            static thread_local PinGUI::Rect _targetRect;
 
-            static PinGUI::Vector2<GUIPos> _lastVector;
+            static thread_local PinGUI::Vector2<GUIPos> _lastVector;
 
-            static wheelingInfo _wheelingInfo;
+            static thread_local wheelingInfo _wheelingInfo;
 
-            static bool _tmpWheelInfo;
+            static thread_local bool _tmpWheelInfo;
 
-            static PinGUI::basicPointer _clFunction;
+            static thread_local PinGUI::basicPointer _clFunction;
 
             //These two variables do something else!!
-            static PinGUI::basicPointer _clickFunction;
+            static thread_local PinGUI::basicPointer _clickFunction;
 
         public:
-            static int _screenWidth;
-            static int _screenHeight;
+            static thread_local int _screenWidth;
+            static thread_local int _screenHeight;
+
+            //Input state of one PinGUI::Context - swapped in when the context becomes current
+            struct contextState{
+                std::unordered_map<unsigned int, bool> keys;
+                gameState currentState = GAME;
+                SDL_Event mainEvent = {};
+                inputState mainInputState = GAMEINPUT;
+                std::shared_ptr<TextStorage> manipulatedText;
+                int positionOfText = -1;
+                writingModInfo writingInfo;
+                manipulatingModInfo manipulatingInfo;
+                std::shared_ptr<GUI_Sprite> manipulatedSprite;
+                bool* needUpdate = nullptr;
+                bool alreadyClicked = false;
+                bool singleClickTracker = false;
+                bool allowWheel = false;
+                bool haveTarget = false;
+                bool isOnWindow = false;
+                Window* lastWindow = nullptr;
+                bool tmpState = false;
+                PinGUI::Rect targetRect;
+                PinGUI::Vector2<GUIPos> lastVector;
+                wheelingInfo wheelInfo;
+                wheelingInfo tmpWheelStorage;
+                bool tmpWheelInfo = false;
+                PinGUI::basicPointer clFunction;
+                PinGUI::basicPointer clickFunction;
+                int screenWidth = 0;
+                int screenHeight = 0;
+            };
+
+            static void swapContext(contextState& state);
 
             static void process(SDL_Event* mainEvent = nullptr);
 
@@ -147,7 +179,7 @@ namespace PinGUI{
 
             static SDL_Event* getEvent_P();
 
-            static void setWheeledInfo(std::shared_ptr<GUI_Sprite> sprite, bool* update, PinGUI::basicPointer f);
+            static void setWheeledInfo(const std::shared_ptr<GUI_Sprite>& sprite, bool* update, const PinGUI::basicPointer& f);
 
             static bool hasTMPWheeledInfo();
 
@@ -161,7 +193,7 @@ namespace PinGUI{
 
             static bool getAllowWheel();
 
-            static wheelingInfo getWheelInfo();
+            static const wheelingInfo& getWheelInfo();
 
             static void setCallbackFunction(PinGUI::basicPointer f);
 
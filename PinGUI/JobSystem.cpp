@@ -0,0 +1,182 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "JobSystem.h"
+
+#include <memory>
+#include <atomic>
+#include <algorithm>
+
+namespace PinGUI{
+
+    std::vector<std::thread> JobSystem::_WORKERS;
+
+    std::deque<std::function<void()>> JobSystem::_JOBS;
+
+    std::mutex JobSystem::_mutex;
+
+    std::condition_variable JobSystem::_condition;
+
+    bool JobSystem::_stop = false;
+
+    void JobSystem::init(unsigned int numOfWorkers){
+
+        //Several PinGUI contexts may start the pool from their threads
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (!_WORKERS.empty())
+            return;
+
+        if (numOfWorkers == 0){
+
+            unsigned int hwThreads = std::thread::hardware_concurrency();
+            numOfWorkers = (hwThreads > 1) ? hwThreads-1 : 1;
+        }
+
+        _stop = false;
+        _WORKERS.reserve(numOfWorkers);
+
+        for (unsigned int i = 0; i < numOfWorkers; i++)
+            _WORKERS.emplace_back(&JobSystem::workerLoop);
+    }
+
+    void JobSystem::destroy(){
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+
+        _condition.notify_all();
+
+        for (std::size_t i = 0; i < _WORKERS.size(); i++)
+            _WORKERS[i].join();
+
+        _WORKERS.clear();
+    }
+
+    std::future<void> JobSystem::submit(std::function<void()> job){
+
+        init();
+
+        //packaged_task is move only, std::function needs something copyable
+        auto task = std::make_shared<std::packaged_task<void()>>(job);
+        std::future<void> result = task->get_future();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _JOBS.push_back([task](){ (*task)(); });
+        }
+
+        _condition.notify_one();
+
+        return result;
+    }
+
+    void JobSystem::parallelFor(std::size_t count, const std::function<void(std::size_t)>& job){
+
+        if (count == 0)
+            return;
+
+        init();
+
+        //Helpers may start after the call returned, so the range lives as long as the last of them
+        struct range{
+            std::atomic<std::size_t> next;
+            std::atomic<std::size_t> done;
+            std::size_t count;
+            const std::function<void(std::size_t)>* job;
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
+
+        auto jobRange = std::make_shared<range>();
+        jobRange->next = 0;
+        jobRange->done = 0;
+        jobRange->count = count;
+        jobRange->job = &job;
+
+        //Indexes are taken one by one, so a slow job doesn't hold the others
+        //The job is touched only for a taken index - the caller is still waiting for it then
+        auto runJobs = [](range& r){
+
+            for (std::size_t i = r.next++; i < r.count; i = r.next++){
+
+                (*r.job)(i);
+
+                if (++r.done == r.count){
+
+                    std::lock_guard<std::mutex> lock(r.mutex);
+                    r.finished.notify_one();
+                }
+            }
+        };
+
+        std::size_t numOfHelpers = std::min(std::size_t(_WORKERS.size()), count-1);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            //Ahead of the queued jobs, the caller is blocked on these
+            for (std::size_t i = 0; i < numOfHelpers; i++)
+                _JOBS.push_front([jobRange, runJobs](){ runJobs(*jobRange); });
+        }
+
+        _condition.notify_all();
+
+        //Calling thread takes the indexes too, so the range ends even if no helper started
+        runJobs(*jobRange);
+
+        //Only the indexes already taken by the helpers are left
+        std::unique_lock<std::mutex> lock(jobRange->mutex);
+        jobRange->finished.wait(lock, [&jobRange](){ return jobRange->done == jobRange->count; });
+    }
+
+    unsigned int JobSystem::getNumOfWorkers(){
+        return (unsigned int)(_WORKERS.size());
+    }
+
+    void JobSystem::workerLoop(){
+
+        while (true){
+
+            std::function<void()> job;
+
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [](){ return _stop || !_JOBS.empty(); });
+
+                //Finish the remaining jobs before quitting
+                if (_stop && _JOBS.empty())
+                    return;
+
+                job = std::move(_JOBS.front());
+                _JOBS.pop_front();
+            }
+
+            job();
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+
+/**
+    Small pool of worker threads for CPU work that doesn't touch OpenGL
+    (image decoding, surface slicing, font loading, vertex data of the GUIManagers...)
+**/
+
+namespace PinGUI{
+
+    class JobSystem{
+
+        private:
+
+            static std::vector<std::thread> _WORKERS;
+
+            //parallelFor puts its helpers to the front, submit to the back
+            static std::deque<std::function<void()>> _JOBS;
+
+            static std::mutex _mutex;
+
+            static std::condition_variable _condition;
+
+            static bool _stop;
+
+            /** Private methods **/
+            static void workerLoop();
+
+        public:
+
+            //0 means number of hardware threads - 1 (at least one worker)
+            static void init(unsigned int numOfWorkers = 0);
+
+            static void destroy();
+
+            //Starts the pool with default settings in case it wasn't initialized yet
+            static std::future<void> submit(std::function<void()> job);
+
+            //Runs job(0) ... job(count-1) on the workers and the calling thread, returns when all are done
+            //Calling thread never waits for a helper that didn't start, queued jobs can't hold it
+            static void parallelFor(std::size_t count, const std::function<void(std::size_t)>& job);
+
+            static unsigned int getNumOfWorkers();
+    };
+}
+
+#endif // JOBSYSTEM_H
@@ -24,29 +24,101 @@
 
 #include "PINGUI.h"
 
-windowVector PINGUI::_ACTIVE_WINDOWS;
+thread_local windowVector PINGUI::_ACTIVE_WINDOWS;
 
-windowVector PINGUI::_NON_ACTIVE_WINDOWS;
+thread_local windowVector PINGUI::_NON_ACTIVE_WINDOWS;
 
-std::shared_ptr<Window> PINGUI::_mainWindow = nullptr;
+thread_local std::shared_ptr<Window> PINGUI::_mainWindow = nullptr;
 
-std::shared_ptr<GUIManager> PINGUI::_mainGUIManager = nullptr;
+thread_local std::shared_ptr<GUIManager> PINGUI::_mainGUIManager = nullptr;
 
-std::shared_ptr<Window> PINGUI::window = nullptr;	
+thread_local std::shared_ptr<Window> PINGUI::window = nullptr;	
 
-std::shared_ptr<WindowTab> PINGUI::winTab = nullptr;
+thread_local std::shared_ptr<WindowTab> PINGUI::winTab = nullptr;
 
-std::shared_ptr<GUIManager> PINGUI::GUI = nullptr;
+thread_local std::shared_ptr<GUIManager> PINGUI::GUI = nullptr;
 
-std::shared_ptr<TextManager> PINGUI::TEXT = nullptr;
+thread_local std::shared_ptr<TextManager> PINGUI::TEXT = nullptr;
 
 std::shared_ptr<Window> _collidingWindow = nullptr;
 
+thread_local startupTimes PINGUI::_startupTimes;
+
+thread_local std::vector<GUIManager*> PINGUI::_RENDER_MANAGERS;
+
+thread_local bool PINGUI::_initialized = false;
+
+thread_local std::unique_ptr<PinGUI::RenderTarget> PINGUI::_layer = nullptr;
+
+thread_local std::unique_ptr<VBO_Manager> PINGUI::_layerQuadVBO = nullptr;
+
+thread_local std::vector<vboData> PINGUI::_layerQuad;
+
+thread_local std::vector<Window*> PINGUI::_LAYER_WINDOWS;
+
+std::atomic<int> PINGUI::_numOfInstances(0);
+
+void PINGUI::swapContext(contextState& state){
+
+    std::swap(_ACTIVE_WINDOWS,state.activeWindows);
+    std::swap(_NON_ACTIVE_WINDOWS,state.nonActiveWindows);
+    std::swap(_mainWindow,state.mainWindow);
+    std::swap(_mainGUIManager,state.mainGUIManager);
+    std::swap(_startupTimes,state.times);
+    std::swap(_RENDER_MANAGERS,state.renderManagers);
+    std::swap(_initialized,state.initialized);
+    std::swap(_layer,state.layer);
+    std::swap(_layerQuadVBO,state.layerQuadVBO);
+    std::swap(_layerQuad,state.layerQuad);
+    std::swap(_LAYER_WINDOWS,state.layerWindows);
+    std::swap(window,state.window);
+    std::swap(winTab,state.winTab);
+    std::swap(GUI,state.GUI);
+    std::swap(TEXT,state.TEXT);
+}
+
+void startupTimes::info(){
+
+    std::cout << "PinGUI startup (ms) - main sheet: " << mainSheet
+              << " window sheet: " << windowSheet
+              << " font: " << font
+              << " shaders: " << shaders
+              << " finalization: " << finalization
+              << " total: " << total << std::endl;
+}
+
 void PINGUI::destroy(){
 
     _ACTIVE_WINDOWS.clear();
     _NON_ACTIVE_WINDOWS.clear();
     _mainWindow.reset();
+
+    //GL objects have to go while the GL context of this PinGUI context is still current
+    _mainGUIManager.reset();
+    enableLayerCache(false);
+    window.reset();
+    winTab.reset();
+    GUI.reset();
+    TEXT.reset();
+
+    VBO_Manager::destroyShared();
+
+    if (!_initialized)
+        return;
+
+    _initialized = false;
+
+    //Sheet regions may point into the pack
+    SheetManager::freeSurfaces();
+
+    //Workers and the pack are shared, the last context stops and closes them
+    if (--_numOfInstances == 0){
+
+        PinGUI::JobSystem::destroy();
+
+        TextManager::releaseFont(PINGUI_DEFAULT_FONT_PATH);
+        PinGUI::AssetPack::close();
+    }
 }
 
 void PINGUI::addWindow(std::shared_ptr<Window> win, bool showAtCreation){
@@ -93,10 +165,68 @@ void PINGUI::normalize() {
 		w->normalize();
 }
 
+void PINGUI::prepareRender(){
+
+    _RENDER_MANAGERS.clear();
+
+    if (_mainGUIManager)
+        _RENDER_MANAGERS.push_back(_mainGUIManager.get());
+
+    //Same windows as render() below
+    for (std::size_t i = 0; i < _ACTIVE_WINDOWS.size(); i++){
+
+        if (_ACTIVE_WINDOWS[i]!=_mainWindow)
+            _ACTIVE_WINDOWS[i]->collectGUIManagers(_RENDER_MANAGERS);
+    }
+
+    if (_mainWindow && _mainWindow->getShow())
+        _mainWindow->collectGUIManagers(_RENDER_MANAGERS);
+
+    //Windows that didn't change have nothing to build
+    _RENDER_MANAGERS.erase(std::remove_if(_RENDER_MANAGERS.begin(),_RENDER_MANAGERS.end(),
+                                          [](GUIManager* manager){ return !manager->needPrepare(); }),
+                           _RENDER_MANAGERS.end());
+
+    //Single manager isn't worth the handoff, render() builds it on this thread
+    if (_RENDER_MANAGERS.size() < 2)
+        return;
+
+    //Workers have their own thread_local copy of the vector
+    std::vector<GUIManager*>& managers = _RENDER_MANAGERS;
+
+    PinGUI::JobSystem::parallelFor(managers.size(),[&managers](std::size_t i){
+
+        PinGUI::AllocationScope allocationScope(PinGUI::ALLOC_RENDER);
+
+        managers[i]->prepareRender();
+    });
+}
+
 void PINGUI::render(){
 
+    PinGUI::AllocationScope allocationScope(PinGUI::ALLOC_RENDER);
+
+    //CPU part first, GL calls stay on this thread
+    prepareRender();
+
+    //Application could change the bindings since the last frame
+    PinGUI::GL_StateManager::invalidate();
+
     PinGUI::Shader_Program::use();
 
+    if (_layer)
+        renderLayer();
+    else
+        renderWindows();
+
+    PinGUI::Shader_Program::unuse();
+
+    //Render is the last thing in the frame
+    PinGUI::AllocationTracker::endFrame();
+}
+
+void PINGUI::renderWindows(){
+
     if (_mainGUIManager)
         _mainGUIManager->render();
 
@@ -112,13 +242,199 @@ void PINGUI::render(){
 
         _mainWindow->render();
     }
+}
 
-    PinGUI::Shader_Program::unuse();
+void PINGUI::renderWindowsIn(const PinGUI::Rect& rect){
+
+    PinGUI::Rect bounds;
+
+    auto reaches = [&](){
+
+        return bounds.x < rect.x + rect.w && rect.x < bounds.x + bounds.w &&
+               bounds.y < rect.y + rect.h && rect.y < bounds.y + bounds.h;
+    };
+
+    //Same order as renderWindows()
+    if (_mainGUIManager && _mainGUIManager->getBounds(bounds) && reaches())
+        _mainGUIManager->render();
+
+    for (std::size_t i = 0; i < _ACTIVE_WINDOWS.size(); i++){
+
+        if (_ACTIVE_WINDOWS[i]!=_mainWindow && _ACTIVE_WINDOWS[i]->getBounds(bounds) && reaches()){
+
+            _ACTIVE_WINDOWS[i]->render();
+        }
+    }
+
+    if (_mainWindow && _mainWindow->getShow() && _mainWindow->getBounds(bounds) && reaches()){
+
+        _mainWindow->render();
+    }
+}
+
+void PINGUI::enableLayerCache(bool state){
+
+    if (state && !_layer){
 
+        _layer = std::make_unique<PinGUI::RenderTarget>();
+        _layerQuadVBO = std::make_unique<VBO_Manager>(1,true);
+        _layerQuad.resize(1);
+        _LAYER_WINDOWS.clear();
+
+    } else if (!state){
+
+        _layer.reset();
+        _layerQuadVBO.reset();
+        _layerQuad.clear();
+        _LAYER_WINDOWS.clear();
+    }
+
+    PinGUI::DamageTracker::setEnabled(state);
+    PinGUI::DamageTracker::addFullDamage();
+}
+
+bool PINGUI::isLayerCacheEnabled(){
+    return _layer != nullptr;
+}
+
+void PINGUI::invalidateLayer(){
+    PinGUI::DamageTracker::addFullDamage();
+}
+
+void PINGUI::collectLayerDamage(){
+
+    _RENDER_MANAGERS.clear();
+
+    if (_mainGUIManager)
+        _RENDER_MANAGERS.push_back(_mainGUIManager.get());
+
+    //Same windows as renderWindows()
+    std::size_t windowCount = 0;
+    bool windowsChanged = false;
+
+    auto trackWindow = [&](Window* win){
+
+        win->collectGUIManagers(_RENDER_MANAGERS);
+
+        if (windowCount >= _LAYER_WINDOWS.size() || _LAYER_WINDOWS[windowCount] != win){
+
+            _LAYER_WINDOWS.resize(windowCount);
+            _LAYER_WINDOWS.push_back(win);
+            windowsChanged = true;
+        }
+
+        windowCount++;
+    };
+
+    for (std::size_t i = 0; i < _ACTIVE_WINDOWS.size(); i++){
+
+        if (_ACTIVE_WINDOWS[i]!=_mainWindow)
+            trackWindow(_ACTIVE_WINDOWS[i].get());
+    }
+
+    if (_mainWindow && _mainWindow->getShow())
+        trackWindow(_mainWindow.get());
+
+    if (windowCount != _LAYER_WINDOWS.size()){
+
+        _LAYER_WINDOWS.resize(windowCount);
+        windowsChanged = true;
+    }
+
+    //Shown, hidden or reordered windows - everything under them may be uncovered
+    if (windowsChanged)
+        PinGUI::DamageTracker::addFullDamage();
+
+    for (std::size_t i = 0; i < _RENDER_MANAGERS.size(); i++)
+        _RENDER_MANAGERS[i]->refresh();
+}
+
+void PINGUI::renderLayer(){
+
+    int width = PinGUI::CameraManager::getScreenWidth();
+    int height = PinGUI::CameraManager::getScreenHeight();
+
+    bool recreated = !_layer->isValid() || _layer->getWidth() != width || _layer->getHeight() != height;
+
+    //Framebuffer isn't available - drawing directly
+    if (!_layer->resize(width,height)){
+
+        renderWindows();
+        return;
+    }
+
+    if (recreated){
+
+        PinGUI::DamageTracker::addFullDamage();
+
+        _layer->fillQuad(_layerQuad[0],PinGUI::Rect(0.0f,0.0f,width,height));
+        _layerQuadVBO->bufferData(0,_layerQuad);
+    }
+
+    collectLayerDamage();
+
+    if (!PinGUI::DamageTracker::isEmpty()){
+
+        _layer->begin(PinGUI::DamageTracker::isFullDamage());
+
+        if (PinGUI::DamageTracker::isFullDamage()){
+
+            renderWindows();
+
+        } else {
+
+            const std::vector<PinGUI::Rect>& rects = PinGUI::DamageTracker::getRects();
+
+            PinGUI::Rect bounds;
+            PinGUI::DamageTracker::getBounds(bounds);
+
+            float damagedArea = 0.0f;
+
+            for (std::size_t i = 0; i < rects.size(); i++)
+                damagedArea += float(rects[i].w) * float(rects[i].h);
+
+            //Layer pixels match the world coordinates, so the rects are scissor boxes as they are
+            if (float(bounds.w) * float(bounds.h) <= damagedArea * PINGUI_DAMAGE_MERGE_RATIO){
+
+                //Close rects - one scissor box and one pass of draws
+                _layer->clearArea(int(bounds.x),int(bounds.y),bounds.w,bounds.h);
+
+                renderWindows();
+
+            } else {
+
+                //Distant rects - every window is drawn only into the rects it reaches
+                for (std::size_t i = 0; i < rects.size(); i++){
+
+                    _layer->clearArea(int(rects[i].x),int(rects[i].y),rects[i].w,rects[i].h);
+
+                    renderWindowsIn(rects[i]);
+                }
+            }
+        }
+
+        _layer->end();
+
+        PinGUI::DamageTracker::clear();
+    }
+
+    GLint previousBlend[4];
+    PinGUI::beginPremultipliedBlend(previousBlend);
+
+    _layerQuadVBO->bind();
+    PinGUI::GL_StateManager::bindTexture(_layer->getTexture());
+
+    VBO_Manager::drawQuads(0);
+
+    PinGUI::GL_StateManager::bindVertexArray(0);
+
+    PinGUI::endPremultipliedBlend(previousBlend);
 }
 
 void PINGUI::update(){
 
+	PinGUI::AllocationScope allocationScope(PinGUI::ALLOC_UPDATE);
+
 	bool allowUpdate = true;
 
 	checkActiveWindows();
@@ -200,11 +516,104 @@ PinGUI::basicPointer PINGUI::getFunctionPointer(){
 
 void PINGUI::initLibrary(int screenWidth, int screenHeight){
 
-    _mainGUIManager = std::make_shared<GUIManager>();
+    auto startTime = std::chrono::steady_clock::now();
+
+    if (!_initialized){
+
+        _initialized = true;
+        _numOfInstances++;
+    }
+
+    //Workers see their own thread_local statics, so the jobs only get references
+    startupTimes& times = _startupTimes;
 
     initStorage();
 
-    SheetManager::loadAllTextures();
+    //SDL_image loads its png backend lazily, do it here before the workers race for it
+    IMG_Init(IMG_INIT_PNG);
+
+    std::vector<SDL_Surface*> mainSheet, windowSheet;
+    bool mainSheetLoaded = false, windowSheetLoaded = false, fontLoaded = false;
+
+    std::future<void> mainSheetJob, windowSheetJob, fontJob;
+
+    //Prebaked pack - sheet regions and font are used straight from the mapped file
+    bool packedSheets = false;
+
+    if (PinGUI::AssetPack::open()){
+
+        auto start = std::chrono::steady_clock::now();
+        packedSheets = SheetManager::loadFromPack(mainSheet);
+        _startupTimes.mainSheet = getElapsedMs(start);
+
+        const PinGUI::packEntry* fontEntry = PinGUI::AssetPack::findEntry(PinGUI::PACK_FONT,0);
+
+        if (fontEntry){
+
+            TextManager::registerFont(PINGUI_DEFAULT_FONT_PATH,reinterpret_cast<const char*>(PinGUI::AssetPack::getEntryData(fontEntry)),std::size_t(fontEntry->size));
+            fontLoaded = true;
+        }
+    }
+
+    if (packedSheets){
+
+        mainSheetLoaded = windowSheetLoaded = true;
+    } else {
+
+        //Decoding and slicing of both sheets don't need GL, so they run on workers
+        mainSheetJob = PinGUI::JobSystem::submit([&](){
+
+            auto start = std::chrono::steady_clock::now();
+            mainSheetLoaded = SheetManager::loadMainSheet(mainSheet);
+            times.mainSheet = getElapsedMs(start);
+        });
+
+        windowSheetJob = PinGUI::JobSystem::submit([&](){
+
+            auto start = std::chrono::steady_clock::now();
+            windowSheetLoaded = SheetManager::loadWindowTextures(windowSheet);
+            times.windowSheet = getElapsedMs(start);
+        });
+    }
+
+    if (!fontLoaded){
+
+        fontJob = PinGUI::JobSystem::submit([&](){
+
+            auto start = std::chrono::steady_clock::now();
+            fontLoaded = TextManager::preloadFont(PINGUI_DEFAULT_FONT_PATH);
+            times.font = getElapsedMs(start);
+        });
+    }
+
+    //Meanwhile the GL thread compiles the shaders
+    auto shaderStart = std::chrono::steady_clock::now();
+
+    PinGUI::Shader_Program::initShaders();
+
+    _startupTimes.shaders = getElapsedMs(shaderStart);
+
+    if (mainSheetJob.valid()) mainSheetJob.wait();
+    if (windowSheetJob.valid()) windowSheetJob.wait();
+    if (fontJob.valid()) fontJob.wait();
+
+    /** Finalization - the only serialized part **/
+    auto finalizationStart = std::chrono::steady_clock::now();
+
+    if (!mainSheetLoaded)
+        ErrorManager::fileError(PINGUI_MAIN_SHEET_PATH);
+
+    if (!windowSheetLoaded)
+        ErrorManager::fileError(PINGUI_WINDOW_SHEET_PATH);
+
+    if (!fontLoaded)
+        ErrorManager::fileError(PINGUI_DEFAULT_FONT_PATH);
+
+    //Order of the surfaces matters - main sheet goes first
+    SheetManager::appendSurfaces(mainSheet);
+    SheetManager::appendSurfaces(windowSheet);
+
+    _mainGUIManager = std::make_shared<GUIManager>();
 
     GUI_Cursor::initCursor();
 
@@ -216,11 +625,23 @@ void PINGUI::initLibrary(int screenWidth, int screenHeight){
 
     PinGUI::Input_Manager::setClickFunction(PINGUI::getFunctionPointer());
 
-    PinGUI::Shader_Program::initShaders();
+    _startupTimes.finalization = getElapsedMs(finalizationStart);
+    _startupTimes.total = getElapsedMs(startTime);
+}
+
+const startupTimes& PINGUI::getStartupTimes(){
+    return _startupTimes;
+}
+
+double PINGUI::getElapsedMs(std::chrono::steady_clock::time_point start){
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 }
 
 void PINGUI::processInput(SDL_Event* event){
 
+    PinGUI::AllocationScope allocationScope(PinGUI::ALLOC_INPUT);
+
     PinGUI::Input_Manager::process(event);
 }
 
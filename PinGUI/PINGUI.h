@@ -26,10 +26,16 @@
 **/
 #include <boost/bind.hpp>
 #include <memory>
+#include <chrono>
+#include <algorithm>
+#include <atomic>
 
 #include "GUI_Elements/Window.h"
 #include "GUI_Elements/WindowButton.h"
 #include "../PinGUI/Shader_Program.h"
+#include "../PinGUI/AllocationTracker.h"
+#include "../PinGUI/JobSystem.h"
+#include "../PinGUI/AssetPack.h"
 
 #define WINDOW_STORAGE_SIZE 200
 
@@ -39,22 +45,71 @@
 
 typedef std::vector<std::shared_ptr<Window>> windowVector;
 
+/**
+    Duration of each initLibrary stage in milliseconds
+    Sheets and font are loaded on workers, shaders and finalization run on the GL thread
+**/
+struct startupTimes{
+
+    double mainSheet = 0.0;
+    double windowSheet = 0.0;
+    double font = 0.0;
+    double shaders = 0.0;
+    double finalization = 0.0;
+    double total = 0.0;
+
+    void info();
+};
+
 class PINGUI
 {
     private:
 
-         static windowVector _ACTIVE_WINDOWS;
+         static thread_local windowVector _ACTIVE_WINDOWS;
 
-         static windowVector _NON_ACTIVE_WINDOWS;
+         static thread_local windowVector _NON_ACTIVE_WINDOWS;
 
-         static std::shared_ptr<Window> _mainWindow;
+         static thread_local std::shared_ptr<Window> _mainWindow;
 
 		 static std::shared_ptr<Window> _collidingWindow;
 
-         static std::shared_ptr<GUIManager> _mainGUIManager;
+         static thread_local std::shared_ptr<GUIManager> _mainGUIManager;
+
+         static thread_local startupTimes _startupTimes;
+
+         //GUIManagers rendered in the current frame - kept to avoid allocating every frame
+         static thread_local std::vector<GUIManager*> _RENDER_MANAGERS;
+
+         static thread_local bool _initialized;
+
+         //GUI layer cache - whole GUI kept in a texture, only damaged areas are drawn again
+         static thread_local std::unique_ptr<PinGUI::RenderTarget> _layer;
+
+         static thread_local std::unique_ptr<VBO_Manager> _layerQuadVBO;
+
+         static thread_local std::vector<vboData> _layerQuad;
+
+         //Windows drawn into the layer, in their order
+         static thread_local std::vector<Window*> _LAYER_WINDOWS;
+
+         //Initialized contexts in the process - the job system is shared by all of them
+         static std::atomic<int> _numOfInstances;
 
          /** Private methods **/
 
+         //Builds the vertex data of all GUIManagers on the workers before the GL work starts
+         static void prepareRender();
+
+         static void renderWindows();
+
+         static void renderLayer();
+
+         //renderWindows() without the windows lying outside of the rect
+         static void renderWindowsIn(const PinGUI::Rect& rect);
+
+         //Finds the damage of this frame, the GUIManagers upload here
+         static void collectLayerDamage();
+
          static void checkActiveWindows();
 
          static void initStorage();
@@ -63,20 +118,45 @@ class PINGUI
 
 		 static std::shared_ptr<Window> findWindow(const windowVector& vector, const std::string& winName);
 
+		 static double getElapsedMs(std::chrono::steady_clock::time_point start);
+
     public:
 
-        static std::shared_ptr<Window> window;
+        static thread_local std::shared_ptr<Window> window;
 
-		static std::shared_ptr<WindowTab> winTab;
+		static thread_local std::shared_ptr<WindowTab> winTab;
 
-		static std::shared_ptr<GUIManager> GUI;
+		static thread_local std::shared_ptr<GUIManager> GUI;
 
-		static std::shared_ptr<TextManager> TEXT;
+		static thread_local std::shared_ptr<TextManager> TEXT;
+
+		//Library state of one PinGUI::Context
+		struct contextState{
+			windowVector activeWindows;
+			windowVector nonActiveWindows;
+			std::shared_ptr<Window> mainWindow;
+			std::shared_ptr<GUIManager> mainGUIManager;
+			startupTimes times;
+			std::vector<GUIManager*> renderManagers;
+			bool initialized = false;
+			std::unique_ptr<PinGUI::RenderTarget> layer;
+			std::unique_ptr<VBO_Manager> layerQuadVBO;
+			std::vector<vboData> layerQuad;
+			std::vector<Window*> layerWindows;
+			std::shared_ptr<Window> window;
+			std::shared_ptr<WindowTab> winTab;
+			std::shared_ptr<GUIManager> GUI;
+			std::shared_ptr<TextManager> TEXT;
+		};
+
+		static void swapContext(contextState& state);
 
 		//Functions
 
         static void initLibrary(int screenWidth, int screenHeight);
 
+        static const startupTimes& getStartupTimes();
+
 		static void normalize();
 
         static void processInput(SDL_Event* event = nullptr);
@@ -94,6 +174,15 @@ class PINGUI
 
         static void render();
 
+        //Opt-in GUI layer cache - the GUI is kept in a texture composited over the scene
+        //and only the changed rectangles are drawn again under the scissor test
+        static void enableLayerCache(bool state);
+
+        static bool isLayerCacheEnabled();
+
+        //Whole layer is drawn again in the next frame
+        static void invalidateLayer();
+
         static void update();
 
         static void setMainWindow(std::shared_ptr<Window> win);
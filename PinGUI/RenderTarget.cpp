@@ -0,0 +1,215 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "RenderTarget.h"
+
+namespace PinGUI{
+
+    RenderTarget::RenderTarget():
+        _framebufferID(0),
+        _textureID(0),
+        _width(0),
+        _height(0),
+        _valid(false),
+        _previousFramebuffer(0),
+        _previousScissorTest(GL_FALSE)
+    {
+
+    }
+
+    RenderTarget::~RenderTarget()
+    {
+        destroy();
+    }
+
+    void RenderTarget::destroy(){
+
+        if (_framebufferID != 0)
+            glDeleteFramebuffers(1,&_framebufferID);
+
+        _framebufferID = 0;
+
+        GL_StateManager::deleteTexture(_textureID);
+
+        _width = 0;
+        _height = 0;
+        _valid = false;
+    }
+
+    bool RenderTarget::resize(int width, int height){
+
+        if (width <= 0 || height <= 0){
+
+            destroy();
+            return false;
+        }
+
+        if (_valid && width == _width && height == _height)
+            return true;
+
+        destroy();
+
+        _width = width;
+        _height = height;
+
+        glGenTextures(1,&_textureID);
+        GL_StateManager::bindTexture(_textureID);
+
+        glTexImage2D(GL_TEXTURE_2D,0,GL_RGBA8,_width,_height,0,GL_RGBA,GL_UNSIGNED_BYTE,nullptr);
+
+        //Content is drawn 1:1 in pixels
+        glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_CLAMP_TO_EDGE);
+
+        GL_StateManager::bindTexture(0);
+
+        GLint previousFramebuffer = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING,&previousFramebuffer);
+
+        glGenFramebuffers(1,&_framebufferID);
+        glBindFramebuffer(GL_FRAMEBUFFER,_framebufferID);
+        glFramebufferTexture2D(GL_FRAMEBUFFER,GL_COLOR_ATTACHMENT0,GL_TEXTURE_2D,_textureID,0);
+
+        _valid = (glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+
+        glBindFramebuffer(GL_FRAMEBUFFER,GLuint(previousFramebuffer));
+
+        if (!_valid)
+            destroy();
+
+        return _valid;
+    }
+
+    void RenderTarget::begin(bool clear){
+
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING,&_previousFramebuffer);
+        glGetIntegerv(GL_VIEWPORT,_previousViewport);
+
+        glBindFramebuffer(GL_FRAMEBUFFER,_framebufferID);
+        glViewport(0,0,_width,_height);
+
+        //Scissor of the application would cut the target in its own coordinates
+        _previousScissorTest = glIsEnabled(GL_SCISSOR_TEST);
+        glDisable(GL_SCISSOR_TEST);
+
+        if (clear){
+
+            glGetFloatv(GL_COLOR_CLEAR_VALUE,_previousClearColor);
+
+            glClearColor(0.0f,0.0f,0.0f,0.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            glClearColor(_previousClearColor[0],_previousClearColor[1],_previousClearColor[2],_previousClearColor[3]);
+        }
+
+        glGetIntegerv(GL_BLEND_SRC_RGB,&_previousBlend[0]);
+        glGetIntegerv(GL_BLEND_DST_RGB,&_previousBlend[1]);
+        glGetIntegerv(GL_BLEND_SRC_ALPHA,&_previousBlend[2]);
+        glGetIntegerv(GL_BLEND_DST_ALPHA,&_previousBlend[3]);
+
+        //Color is blended as usual, alpha accumulates - the result is premultiplied
+        glBlendFuncSeparate(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA,GL_ONE,GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    void RenderTarget::clearArea(int x, int y, int width, int height){
+
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(x,y,width,height);
+
+        glGetFloatv(GL_COLOR_CLEAR_VALUE,_previousClearColor);
+
+        glClearColor(0.0f,0.0f,0.0f,0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        glClearColor(_previousClearColor[0],_previousClearColor[1],_previousClearColor[2],_previousClearColor[3]);
+    }
+
+    void RenderTarget::end(){
+
+        glBlendFuncSeparate(_previousBlend[0],_previousBlend[1],_previousBlend[2],_previousBlend[3]);
+
+        if (_previousScissorTest)
+            glEnable(GL_SCISSOR_TEST);
+        else
+            glDisable(GL_SCISSOR_TEST);
+
+        glBindFramebuffer(GL_FRAMEBUFFER,GLuint(_previousFramebuffer));
+        glViewport(_previousViewport[0],_previousViewport[1],_previousViewport[2],_previousViewport[3]);
+    }
+
+    void RenderTarget::fillQuad(vboData& quad, const PinGUI::Rect& rect){
+
+        float left = rect.x;
+        float right = rect.x + rect.w;
+        float bottom = rect.y;
+        float top = rect.y + rect.h;
+
+        quad.vertices[0].setPosition(right, top);
+        quad.vertices[1].setPosition(left, top);
+        quad.vertices[2].setPosition(left, bottom);
+        quad.vertices[3].setPosition(right, bottom);
+
+        //Shader flips V for surface textures, framebuffer rows already go bottom up
+        quad.vertices[0].setUV(1.0f, 0.0f);
+        quad.vertices[1].setUV(0.0f, 0.0f);
+        quad.vertices[2].setUV(0.0f, 1.0f);
+        quad.vertices[3].setUV(1.0f, 1.0f);
+
+        for (int i = 0; i < PINGUI_QUAD_VERTICES; i++)
+            quad.vertices[i].setColor(255, 255, 255, 255);
+    }
+
+    GLuint RenderTarget::getTexture(){
+        return _textureID;
+    }
+
+    int RenderTarget::getWidth(){
+        return _width;
+    }
+
+    int RenderTarget::getHeight(){
+        return _height;
+    }
+
+    bool RenderTarget::isValid(){
+        return _valid;
+    }
+
+    void beginPremultipliedBlend(GLint previousBlend[4]){
+
+        glGetIntegerv(GL_BLEND_SRC_RGB,&previousBlend[0]);
+        glGetIntegerv(GL_BLEND_DST_RGB,&previousBlend[1]);
+        glGetIntegerv(GL_BLEND_SRC_ALPHA,&previousBlend[2]);
+        glGetIntegerv(GL_BLEND_DST_ALPHA,&previousBlend[3]);
+
+        glBlendFunc(GL_ONE,GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    void endPremultipliedBlend(const GLint previousBlend[4]){
+        glBlendFuncSeparate(previousBlend[0],previousBlend[1],previousBlend[2],previousBlend[3]);
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef RENDERTARGET_H
+#define RENDERTARGET_H
+
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "GL_StateManager.h"
+#include "stuff.h"
+#include "PinGUI_Rect.hpp"
+
+namespace PinGUI{
+
+    /**
+        Offscreen RGBA texture with its framebuffer
+        Content is rendered with premultiplied alpha, so it has to be composited with GL_ONE, GL_ONE_MINUS_SRC_ALPHA
+    **/
+    class RenderTarget
+    {
+        private:
+
+            GLuint _framebufferID;
+
+            GLuint _textureID;
+
+            int _width;
+
+            int _height;
+
+            bool _valid;
+
+            //Application state restored by end()
+            GLint _previousFramebuffer;
+
+            GLint _previousViewport[4];
+
+            GLfloat _previousClearColor[4];
+
+            GLint _previousBlend[4];
+
+            GLboolean _previousScissorTest;
+
+            /** Private methods **/
+            void destroy();
+
+        public:
+
+            RenderTarget();
+
+            ~RenderTarget();
+
+            RenderTarget(const RenderTarget&) = delete;
+
+            RenderTarget& operator=(const RenderTarget&) = delete;
+
+            //Storage is recreated only when the size changed, returns false if the framebuffer isn't usable
+            bool resize(int width, int height);
+
+            //Binds the target, sets its viewport and premultiplied blending
+            void begin(bool clear = true);
+
+            //Clears only the area and leaves the scissor test on it, for partial redraws between begin() and end()
+            void clearArea(int x, int y, int width, int height);
+
+            void end();
+
+            //Quad drawing the whole texture over the rect
+            void fillQuad(vboData& quad, const PinGUI::Rect& rect);
+
+            GLuint getTexture();
+
+            int getWidth();
+
+            int getHeight();
+
+            bool isValid();
+    };
+
+    //Sets premultiplied blending for drawing a RenderTarget texture, previous blending goes to the array
+    void beginPremultipliedBlend(GLint previousBlend[4]);
+
+    void endPremultipliedBlend(const GLint previousBlend[4]);
+}
+
+#endif // RENDERTARGET_H
@@ -26,37 +26,240 @@
 
 namespace PinGUI{
 
-    int Shader_Program::_attributes = 0;
+    thread_local int Shader_Program::_attributes = 0;
 
-    GLuint Shader_Program::_programID = 0;
+    thread_local GLuint Shader_Program::_programID = 0;
 
-    GLuint Shader_Program::_vertexShaderID = 0;
+    thread_local GLuint Shader_Program::_vertexShaderID = 0;
 
-    GLuint Shader_Program::_fragmentShaderID = 0;
+    thread_local GLuint Shader_Program::_fragmentShaderID = 0;
 
-    GLint Shader_Program::_samplerLocation = 0;
+    thread_local GLint Shader_Program::_samplerLocation = 0;
+
+    thread_local bool Shader_Program::_loadedFromCache = false;
+
+    thread_local GLuint Shader_Program::_sdfProgramID = 0;
+
+    thread_local GLint Shader_Program::_sdfSamplerLocation = 0;
+
+    thread_local GLint Shader_Program::_sdfProjectionLocation = 0;
+
+    thread_local glm::mat4 Shader_Program::_projection = glm::mat4(1.0f);
+
+    void Shader_Program::swapContext(contextState& state){
+
+        std::swap(_attributes,state.attributes);
+        std::swap(_programID,state.programID);
+        std::swap(_vertexShaderID,state.vertexShaderID);
+        std::swap(_fragmentShaderID,state.fragmentShaderID);
+        std::swap(_samplerLocation,state.samplerLocation);
+        std::swap(_loadedFromCache,state.loadedFromCache);
+        std::swap(_sdfProgramID,state.sdfProgramID);
+        std::swap(_sdfSamplerLocation,state.sdfSamplerLocation);
+        std::swap(_sdfProjectionLocation,state.sdfProjectionLocation);
+        std::swap(_projection,state.projection);
+    }
 
     void Shader_Program::initShaders(){
 
-        // Compile our color shader
-        compileShaders("PinGUI/Shaders/vertexShader.txt", "PinGUI/Shaders/fragmentShader.txt");
+        //Sources are taken from the asset pack if it's opened
+        std::string vertexShaderSource = loadShaderSource(PINGUI_VERTEX_SHADER_PATH,PACK_VERTEX_SHADER);
+        std::string fragmentShaderSource = loadShaderSource(PINGUI_FRAGMENT_SHADER_PATH,PACK_FRAGMENT_SHADER);
+
+        bool cacheSupported = programBinarySupported();
+        uint64_t key = 0;
+
+        _loadedFromCache = false;
+
+        if (cacheSupported){
+
+            key = getCacheKey(vertexShaderSource,fragmentShaderSource);
+            _loadedFromCache = loadProgramBinary(key);
+        }
+
+        if (_loadedFromCache){
+
+            //Attribute locations are stored in the binary, this only sets their count
+            bindAttributes();
+        }
+        else {
+
+            // Compile our color shader
+            compileShaderSources(vertexShaderSource,fragmentShaderSource);
+
+            //Now add variables
+            bindAttributes();
+
+            if (cacheSupported)
+                glProgramParameteri(_programID,GL_PROGRAM_BINARY_RETRIEVABLE_HINT,GL_TRUE);
+
+            //Link the shaders
+            linkShaders();
+
+            if (cacheSupported)
+                saveProgramBinary(key);
+        }
+
+        PinGUI::CameraManager::setMatrixLocation(PROJECTION,Shader_Program::getUniformLocation("P"));
+
+        _samplerLocation = Shader_Program::getUniformLocation("sampler");
+    }
+
+    void Shader_Program::bindAttributes(){
+
+        _attributes = 0;
 
-        //Now add variables
         addAttribute("vertexPosition");
         addAttribute("vertexColor");
         addAttribute("vertexUV");
         addAttribute("instancePos");
+    }
+
+    void Shader_Program::initSdfProgram(){
+
+        //Built like the main program, which is kept aside meanwhile - it's small enough to skip the binary cache
+        GLuint mainProgramID = _programID;
+        int mainAttributes = _attributes;
+
+        compileShaderSources(loadShaderSource(PINGUI_VERTEX_SHADER_PATH,PACK_VERTEX_SHADER),
+                             loadShaderSource(PINGUI_SDF_FRAGMENT_SHADER_PATH,PACK_SDF_FRAGMENT_SHADER));
+
+        bindAttributes();
 
-        //Link the shaders
         linkShaders();
 
-        PinGUI::CameraManager::setMatrixLocation(PROJECTION,Shader_Program::getUniformLocation("P"));
+        _sdfProgramID = _programID;
+        _sdfSamplerLocation = Shader_Program::getUniformLocation("sampler");
+        _sdfProjectionLocation = Shader_Program::getUniformLocation("P");
 
-        _samplerLocation = Shader_Program::getUniformLocation("sampler");
+        _programID = mainProgramID;
+        _attributes = mainAttributes;
+    }
+
+    bool Shader_Program::programBinarySupported(){
+
+        if (!GLEW_VERSION_4_1 && !GLEW_ARB_get_program_binary)
+            return false;
+
+        GLint numOfFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS,&numOfFormats);
+
+        return numOfFormats > 0;
+    }
+
+    uint64_t Shader_Program::getCacheKey(const std::string& vertexShaderSource,const std::string& fragmentShaderSource){
+
+        const GLubyte* vendor = glGetString(GL_VENDOR);
+        const GLubyte* renderer = glGetString(GL_RENDERER);
+        const GLubyte* version = glGetString(GL_VERSION);
+
+        std::string keySource;
+        keySource += vendor ? reinterpret_cast<const char*>(vendor) : "";
+        keySource += '\n';
+        keySource += renderer ? reinterpret_cast<const char*>(renderer) : "";
+        keySource += '\n';
+        keySource += version ? reinterpret_cast<const char*>(version) : "";
+        keySource += '\n';
+        keySource += vertexShaderSource;
+        keySource += '\n';
+        keySource += fragmentShaderSource;
+
+        //FNV-1a
+        uint64_t hash = 14695981039346656037ULL;
+
+        for (std::size_t i = 0; i < keySource.size(); i++){
+            hash ^= static_cast<unsigned char>(keySource[i]);
+            hash *= 1099511628211ULL;
+        }
+
+        return hash;
+    }
+
+    bool Shader_Program::loadProgramBinary(uint64_t key){
+
+        std::ifstream file(PINGUI_SHADER_CACHE_PATH, std::ios::binary | std::ios::ate);
+
+        if (file.fail())
+            return false;
+
+        std::streamoff fileSize = file.tellg();
+        file.seekg(0,std::ios::beg);
+
+        shaderCacheHeader header;
+
+        if (fileSize < std::streamoff(sizeof(header)) || !file.read(reinterpret_cast<char*>(&header),sizeof(header)))
+            return false;
+
+        //Different driver or changed shaders - compile again
+        if (header.magic != PINGUI_SHADER_CACHE_MAGIC || header.key != key || header.length == 0)
+            return false;
+
+        //Truncated or corrupted file - the length has to be exactly the rest of it
+        if (std::streamoff(header.length) != fileSize - std::streamoff(sizeof(header)))
+            return false;
+
+        std::vector<char> binary(header.length);
+
+        if (!file.read(binary.data(),std::streamsize(binary.size())))
+            return false;
+
+        _programID = glCreateProgram();
+        glProgramBinary(_programID,GLenum(header.format),binary.data(),GLsizei(binary.size()));
+
+        //Driver can still reject the binary
+        GLint isLinked = GL_FALSE;
+        glGetProgramiv(_programID, GL_LINK_STATUS, &isLinked);
+
+        if (isLinked == GL_FALSE){
+
+            glDeleteProgram(_programID);
+            _programID = 0;
+            return false;
+        }
+
+        return true;
+    }
+
+    void Shader_Program::saveProgramBinary(uint64_t key){
+
+        GLint length = 0;
+        glGetProgramiv(_programID,GL_PROGRAM_BINARY_LENGTH,&length);
+
+        if (length <= 0)
+            return;
+
+        std::vector<char> binary(length);
+        GLenum format = 0;
+        glGetProgramBinary(_programID,length,&length,&format,binary.data());
+
+        shaderCacheHeader header;
+        header.magic = PINGUI_SHADER_CACHE_MAGIC;
+        header.format = format;
+        header.key = key;
+        header.length = uint32_t(length);
+        header.reserved = 0;
+
+        //Failing to write the cache isn't fatal, next launch just compiles again
+        std::ofstream file(PINGUI_SHADER_CACHE_PATH, std::ios::binary | std::ios::trunc);
+
+        if (file.fail())
+            return;
+
+        file.write(reinterpret_cast<const char*>(&header),sizeof(header));
+        file.write(binary.data(),length);
+    }
+
+    bool Shader_Program::wasLoadedFromCache(){
+        return _loadedFromCache;
     }
 
     void Shader_Program::compileShaders(const std::string& vertexShaderFilePath,const std::string& fragmentShaderFilePath){
 
+        compileShaderSources(readShaderFile(vertexShaderFilePath),readShaderFile(fragmentShaderFilePath));
+    }
+
+    void Shader_Program::compileShaderSources(const std::string& vertexShaderSource,const std::string& fragmentShaderSource){
+
         _vertexShaderID = glCreateShader(GL_VERTEX_SHADER);
         if (_vertexShaderID==0){
             ErrorManager::systemError("_vertexShader creation fail");
@@ -68,12 +271,12 @@ namespace PinGUI{
         }
         _programID = glCreateProgram();
 
-        compileShader(vertexShaderFilePath,_vertexShaderID);
-        compileShader(fragmentShaderFilePath,_fragmentShaderID);
+        compileShader(vertexShaderSource,_vertexShaderID);
+        compileShader(fragmentShaderSource,_fragmentShaderID);
 
     }
 
-    void Shader_Program::compileShader(const std::string& filePath,GLuint id){
+    std::string Shader_Program::readShaderFile(const std::string& filePath){
 
         std::ifstream vertexFile(filePath);
 
@@ -90,7 +293,22 @@ namespace PinGUI{
 
         vertexFile.close();
 
-        const char* contentsPtr = fileContent.c_str();
+        return fileContent;
+    }
+
+    std::string Shader_Program::loadShaderSource(const std::string& filePath, packShader packID){
+
+        const packEntry* entry = AssetPack::findEntry(PACK_SHADER,packID);
+
+        if (entry)
+            return std::string(reinterpret_cast<const char*>(AssetPack::getEntryData(entry)),std::size_t(entry->size));
+
+        return readShaderFile(filePath);
+    }
+
+    void Shader_Program::compileShader(const std::string& source,GLuint id){
+
+        const char* contentsPtr = source.c_str();
         glShaderSource(id,1,&contentsPtr,nullptr);
 
         glCompileShader(id);
@@ -155,31 +373,50 @@ namespace PinGUI{
 
     void Shader_Program::use(){
 
-        glUseProgram(_programID);
+        GL_StateManager::useProgram(_programID);
 
-        for (int i=0;i<_attributes;i++){
-            glEnableVertexAttribArray(i);
-        }
+        //Attributes are enabled in the VAOs, see VBO_Manager::createVAO
+
+        GL_StateManager::activeTexture(GL_TEXTURE0);
 
-        glActiveTexture(GL_TEXTURE0);
+        GL_StateManager::setUniform(_samplerLocation, 0);
 
-        glUniform1i(_samplerLocation, 0);
+        _projection = PinGUI::CameraManager::getCameraMatrix();
 
-        //Projection matrix
-        glUniformMatrix4fv(PinGUI::CameraManager::getMatrixLocation(PROJECTION), 1, GL_FALSE, glm::value_ptr(PinGUI::CameraManager::getCameraMatrix()));
+        //Projection matrix - uploaded only when the camera changed
+        GL_StateManager::setUniform(PinGUI::CameraManager::getMatrixLocation(PROJECTION), _projection);
 
     }
 
-    void Shader_Program::unuse(){
+    void Shader_Program::setProjection(const glm::mat4& projection){
 
-        glUseProgram(0);
+        _projection = projection;
 
-        for (int i=0;i<_attributes;i++){
-            glDisableVertexAttribArray(i);
-        }
+        GL_StateManager::setUniform(PinGUI::CameraManager::getMatrixLocation(PROJECTION), projection);
+    }
+
+    void Shader_Program::beginSdf(){
+
+        if (_sdfProgramID == 0)
+            initSdfProgram();
+
+        GL_StateManager::useProgram(_sdfProgramID);
+
+        //Uniforms are kept per program, these go through only when they changed
+        GL_StateManager::setUniform(_sdfSamplerLocation, 0);
+        GL_StateManager::setUniform(_sdfProjectionLocation, _projection);
+    }
+
+    void Shader_Program::endSdf(){
+        GL_StateManager::useProgram(_programID);
+    }
+
+    void Shader_Program::unuse(){
+
+        GL_StateManager::useProgram(0);
 
         //unbind the texture
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GL_StateManager::bindTexture(0);
 
     }
 
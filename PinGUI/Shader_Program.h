@@ -33,43 +33,126 @@
 #include "ErrorManager.h"
 #include "stuff.h"
 #include "CameraManager.h"
+#include "AssetPack.h"
+#include "GL_StateManager.h"
+
+#define PINGUI_VERTEX_SHADER_PATH "PinGUI/Shaders/vertexShader.txt"
+
+#define PINGUI_FRAGMENT_SHADER_PATH "PinGUI/Shaders/fragmentShader.txt"
+
+#define PINGUI_SDF_FRAGMENT_SHADER_PATH "PinGUI/Shaders/sdfFragmentShader.txt"
+
+#define PINGUI_SHADER_CACHE_PATH "PinGUI/Shaders/program.cache"
+
+#define PINGUI_SHADER_CACHE_MAGIC 0x48435350
+
+namespace PinGUI{
+
+    //Header of the program binary cache file, the binary itself follows
+    struct shaderCacheHeader{
+        uint32_t magic;
+        uint32_t format;
+        uint64_t key;
+        uint32_t length;
+        uint32_t reserved;
+    };
+}
 
 namespace PinGUI{
     class Shader_Program
     {
         private:
 
-            static int _attributes;
+            static thread_local int _attributes;
+
+            static thread_local GLuint _programID;
+
+            static thread_local GLuint _vertexShaderID;
+
+            static thread_local GLuint _fragmentShaderID;
+
+            static thread_local GLint _samplerLocation;
+
+            static thread_local bool _loadedFromCache;
 
-            static GLuint _programID;
+            //Program for the SDF texts, built with the first one
+            static thread_local GLuint _sdfProgramID;
 
-            static GLuint _vertexShaderID;
+            static thread_local GLint _sdfSamplerLocation;
 
-            static GLuint _fragmentShaderID;
+            static thread_local GLint _sdfProjectionLocation;
 
-            static GLint _samplerLocation;
+            //Projection set by use() or setProjection, the SDF program takes it over
+            static thread_local glm::mat4 _projection;
 
             /**
                 Private methods
             **/
-            static void compileShader(const std::string& filePath,GLuint id);
+            static void compileShader(const std::string& source,GLuint id);
+
+            static bool programBinarySupported();
+
+            //Key of the cache - driver vendor, renderer, version and both shader sources
+            static uint64_t getCacheKey(const std::string& vertexShaderSource,const std::string& fragmentShaderSource);
+
+            static bool loadProgramBinary(uint64_t key);
+
+            static void saveProgramBinary(uint64_t key);
+
+            static void bindAttributes();
+
+            static void initSdfProgram();
 
         public:
 
+            //Program of one PinGUI::Context - GL objects belong to the GL context the PinGUI::Context renders with
+            struct contextState{
+                int attributes = 0;
+                GLuint programID = 0;
+                GLuint vertexShaderID = 0;
+                GLuint fragmentShaderID = 0;
+                GLint samplerLocation = 0;
+                bool loadedFromCache = false;
+                GLuint sdfProgramID = 0;
+                GLint sdfSamplerLocation = 0;
+                GLint sdfProjectionLocation = 0;
+                glm::mat4 projection = glm::mat4(1.0f);
+            };
+
+            static void swapContext(contextState& state);
+
             static void initShaders();
 
             static void compileShaders(const std::string& vertexShaderFilePath,const std::string& fragmentShaderFilePath);
 
+            static void compileShaderSources(const std::string& vertexShaderSource,const std::string& fragmentShaderSource);
+
+            static std::string readShaderFile(const std::string& filePath);
+
+            //Source from the asset pack, from the file if the pack doesn't have it
+            static std::string loadShaderSource(const std::string& filePath, packShader packID);
+
             static void linkShaders();
 
             static void addAttribute(const std::string& attributeName);
 
             static GLuint getUniformLocation(const std::string& uniformName);
 
+            //True if the last initShaders took the linked program from the binary cache
+            static bool wasLoadedFromCache();
+
             static void use();
 
+            //Overrides the camera projection until the next use() - for rendering into a RenderTarget
+            static void setProjection(const glm::mat4& projection);
+
             static void unuse();
 
+            //Switches to the SDF text program with the current projection, endSdf goes back
+            static void beginSdf();
+
+            static void endSdf();
+
     };
 }
 
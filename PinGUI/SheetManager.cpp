@@ -25,7 +25,11 @@
 #include "SheetManager.h"
 #include <iostream>
 
-std::vector<SDL_Surface*> SheetManager::_SURFACES;
+thread_local std::vector<SDL_Surface*> SheetManager::_SURFACES;
+
+void SheetManager::swapContext(contextState& state){
+    _SURFACES.swap(state.surfaces);
+}
 
 /**
     ORDER OF LOADING IS VERY IMPORTANT!
@@ -33,42 +37,99 @@ std::vector<SDL_Surface*> SheetManager::_SURFACES;
 
 void SheetManager::loadAllTextures(){
 
+    if (!loadMainSheet(_SURFACES))
+        ErrorManager::fileError(PINGUI_MAIN_SHEET_PATH);
+
+    if (!loadWindowTextures(_SURFACES))
+        ErrorManager::fileError(PINGUI_WINDOW_SHEET_PATH);
+}
+
+bool SheetManager::loadMainSheet(std::vector<SDL_Surface*>& storage){
+
     //First i load whole image into 1 surface
     SDL_Surface* wholeSurface = nullptr;
-    wholeSurface = IMG_Load("PinGUI/TextManager/Images/TextManagerSheet.png");
+    wholeSurface = IMG_Load(PINGUI_MAIN_SHEET_PATH);
 
-    //Error checking
+    //Error checking - reported by the caller as this can run on a worker thread
     if (wholeSurface==nullptr){
-        ErrorManager::fileError("PinGUI/TextManager/Images/TextManagerSheet.png");
+        return false;
     }
 
     //I load all surfaces i need only once(at startup) so i have them loaded all the time prepared for use
-	loadSurface(BACKGROUND, wholeSurface);
-    loadSurface(BOARD,wholeSurface);
-    loadSurface(BORDER_LINE,wholeSurface);
-    loadSurface(BORDER_TL,wholeSurface);
-    loadSurface(BORDER_BL,wholeSurface);
-    loadSurface(BORDER_TR,wholeSurface);
-    loadSurface(BORDER_BR,wholeSurface);
+	loadSurface(BACKGROUND,wholeSurface,storage);
+    loadSurface(BOARD,wholeSurface,storage);
+    loadSurface(BORDER_LINE,wholeSurface,storage);
+    loadSurface(BORDER_TL,wholeSurface,storage);
+    loadSurface(BORDER_BL,wholeSurface,storage);
+    loadSurface(BORDER_TR,wholeSurface,storage);
+    loadSurface(BORDER_BR,wholeSurface,storage);
 
-    loadSurface(ARROW_PLUS,wholeSurface);
-    loadSurface(ARROW_MINUS,wholeSurface);
+    loadSurface(ARROW_PLUS,wholeSurface,storage);
+    loadSurface(ARROW_MINUS,wholeSurface,storage);
 
-    loadSurface(VOLUME_BACK,wholeSurface);
-    loadSurface(VOLUME_MOVER,wholeSurface);
-    loadSurface(VOLUME_FILL,wholeSurface);
+    loadSurface(VOLUME_BACK,wholeSurface,storage);
+    loadSurface(VOLUME_MOVER,wholeSurface,storage);
+    loadSurface(VOLUME_FILL,wholeSurface,storage);
 
-    loadSurface(CHECKBOX,wholeSurface);
-    loadSurface(NON_CHECKBOX,wholeSurface);
+    loadSurface(CHECKBOX,wholeSurface,storage);
+    loadSurface(NON_CHECKBOX,wholeSurface,storage);
 
-    loadComboBoxArrow(wholeSurface);
+    loadComboBoxArrow(wholeSurface,storage);
 
     SDL_FreeSurface(wholeSurface);
 
-    loadWindowTextures();
+    return true;
+}
+
+bool SheetManager::loadFromPack(std::vector<SDL_Surface*>& storage){
+
+    //Pack made for different sheets can't be used
+    if (PinGUI::AssetPack::getNumOfSurfaces() != BLANK_SURFACE)
+        return false;
+
+    std::vector<SDL_Surface*> tmpStorage;
+    tmpStorage.reserve(BLANK_SURFACE);
+
+    for (uint32_t i = 0; i < BLANK_SURFACE; i++){
+
+        const PinGUI::packEntry* entry = PinGUI::AssetPack::findEntry(PinGUI::PACK_SURFACE,i);
+
+        if (!entry || entry->size < uint64_t(entry->width)*entry->height*4){
+
+            for (std::size_t j = 0; j < tmpStorage.size(); j++)
+                SDL_FreeSurface(tmpStorage[j]);
+
+            return false;
+        }
+
+        void* pixels = const_cast<uint8_t*>(PinGUI::AssetPack::getEntryData(entry));
+
+        SDL_Surface* tmpSurface = SDL_CreateRGBSurfaceWithFormatFrom(pixels,int(entry->width),int(entry->height),32,int(entry->width)*4,SDL_PIXELFORMAT_RGBA32);
+
+        SDL_SetSurfaceBlendMode(tmpSurface,SDL_BLENDMODE_NONE);
+
+        tmpStorage.push_back(tmpSurface);
+    }
+
+    storage.insert(storage.end(),tmpStorage.begin(),tmpStorage.end());
+
+    return true;
 }
 
-void SheetManager::loadSurface(enum surfaceType type,SDL_Surface* wholeSurface){
+void SheetManager::appendSurfaces(const std::vector<SDL_Surface*>& surfaces){
+
+    _SURFACES.insert(_SURFACES.end(),surfaces.begin(),surfaces.end());
+}
+
+void SheetManager::freeSurfaces(){
+
+    for (std::size_t i = 0; i < _SURFACES.size(); i++)
+        SDL_FreeSurface(_SURFACES[i]);
+
+    _SURFACES.clear();
+}
+
+void SheetManager::loadSurface(enum surfaceType type,SDL_Surface* wholeSurface, std::vector<SDL_Surface*>& storage){
 
     //Rect to store the cropped area pos and dimensions
     SDL_Rect tmp;
@@ -91,7 +152,7 @@ void SheetManager::loadSurface(enum surfaceType type,SDL_Surface* wholeSurface){
     //Bliting the area onto my new surface
     SDL_BlitSurface(wholeSurface,&tmp,tmpSurface,NULL);
 
-    addToVector(tmpSurface);
+    addToVector(tmpSurface,storage);
 }
 
 SDL_Rect SheetManager::manageCroppedRect(surfaceType* type){
@@ -146,15 +207,15 @@ SDL_Rect SheetManager::manageCroppedRect(surfaceType* type){
 	return SDL_Rect{};
 }
 
-void SheetManager::loadComboBoxArrow(SDL_Surface*& sourceSurface){
+void SheetManager::loadComboBoxArrow(SDL_Surface*& sourceSurface, std::vector<SDL_Surface*>& storage){
 
 	SDL_Rect tmpRect{ PINGUI_COMBO_BOX_ARROW_X , PINGUI_COMBO_BOX_ARROW_Y, PINGUI_COMBO_BOX_ARROW_W, PINGUI_COMBO_BOX_ARROW_H };
 
-    uploadSurface(tmpRect,sourceSurface);
+    uploadSurface(tmpRect,sourceSurface,storage);
 }
 
-void SheetManager::addToVector(SDL_Surface* newSurface){
-    _SURFACES.push_back(newSurface);
+void SheetManager::addToVector(SDL_Surface* newSurface, std::vector<SDL_Surface*>& storage){
+    storage.push_back(newSurface);
 }
 
 SDL_Surface* SheetManager::getSurface(enum surfaceType type){
@@ -171,23 +232,25 @@ SDL_Surface* SheetManager::cloneSurface(enum surfaceType type){
 
     return tmpSurface;
 }
-void SheetManager::loadWindowTextures(){
+bool SheetManager::loadWindowTextures(std::vector<SDL_Surface*>& storage){
 
     SDL_Surface* wholeSurface = nullptr;
-    wholeSurface = IMG_Load("PinGUI/TextManager/Images/WindowSheet.png");
+    wholeSurface = IMG_Load(PINGUI_WINDOW_SHEET_PATH);
 
     //Error checking
     if (wholeSurface==nullptr){
-        ErrorManager::fileError("PinGUI/TextManager/Images/WindowSheet.png");
+        return false;
     }
 
-    loadWindow(wholeSurface);
-    loadWindowTab(wholeSurface);
-    loadWindowExitButton(wholeSurface);
-    loadWindowScroller(wholeSurface);
-    loadWindowScrollerArrows(wholeSurface);
-    loadWindowScrollerFill(wholeSurface);
+    loadWindow(wholeSurface,storage);
+    loadWindowTab(wholeSurface,storage);
+    loadWindowExitButton(wholeSurface,storage);
+    loadWindowScroller(wholeSurface,storage);
+    loadWindowScrollerArrows(wholeSurface,storage);
+    loadWindowScrollerFill(wholeSurface,storage);
     SDL_FreeSurface(wholeSurface);
+
+    return true;
 }
 
 SDL_Surface* SheetManager::createClipboard(int w, int h, surfaceType type, lineType line)
@@ -340,27 +403,27 @@ void SheetManager::addVertexBorders(SDL_Surface*& target, lineType type){
     SDL_BlitSurface(_SURFACES[mainType+3],NULL,target,&tmpRect);
 }
 
-void SheetManager::loadWindowTab(SDL_Surface*& sourceSurface){
+void SheetManager::loadWindowTab(SDL_Surface*& sourceSurface, std::vector<SDL_Surface*>& storage){
 
     //At first i load tab texture
 	SDL_Rect tabRect{ PINGUI_WINDOW_TAB_X , PINGUI_WINDOW_TAB_Y , PINGUI_WINDOW_TAB_W , PINGUI_WINDOW_TAB_H };
 
-    uploadSurface(tabRect,sourceSurface);
+    uploadSurface(tabRect,sourceSurface,storage);
 
     //Now the line
 	SDL_Rect tabLine{ PINGUI_WINDOW_TAB_LINE_X , PINGUI_WINDOW_TAB_LINE_X , PINGUI_WINDOW_TAB_LINE_W, PINGUI_WINDOW_TAB_LINE_H };
 
-    uploadSurface(tabLine,sourceSurface);
+    uploadSurface(tabLine,sourceSurface,storage);
 }
 
-void SheetManager::loadWindowExitButton(SDL_Surface*& sourceSurface){
+void SheetManager::loadWindowExitButton(SDL_Surface*& sourceSurface, std::vector<SDL_Surface*>& storage){
 
 	SDL_Rect tmpRect{ PINGUI_WINDOW_EXITBUTTON_X, PINGUI_WINDOW_EXITBUTTON_Y , PINGUI_WINDOW_EXITBUTTON_W , PINGUI_WINDOW_EXITBUTTON_H };
 
-    uploadSurface(tmpRect,sourceSurface);
+    uploadSurface(tmpRect,sourceSurface,storage);
 }
 
-void SheetManager::uploadSurface(SDL_Rect& cropRect, SDL_Surface* sourceSurface){
+void SheetManager::uploadSurface(SDL_Rect& cropRect, SDL_Surface* sourceSurface, std::vector<SDL_Surface*>& storage){
 
     SDL_Surface* targetSurface;
     targetSurface = SDL_CreateRGBSurface(sourceSurface->flags,cropRect.w, cropRect.h,
@@ -375,7 +438,7 @@ void SheetManager::uploadSurface(SDL_Rect& cropRect, SDL_Surface* sourceSurface)
     //Bliting the area onto my new surface
     SDL_BlitSurface(sourceSurface,&cropRect,targetSurface,NULL);
 
-    addToVector(targetSurface);
+    addToVector(targetSurface,storage);
 }
 
 SDL_Surface* SheetManager::createWindowTab(int w, int h){
@@ -408,39 +471,39 @@ void SheetManager::addTabLines(SDL_Surface*& target){
     SDL_BlitScaled(_SURFACES[WINDOW_TAB_LINE],NULL,target,&tmpRect);
 }
 
-void SheetManager::loadWindow(SDL_Surface*& sourceSurface){
+void SheetManager::loadWindow(SDL_Surface*& sourceSurface, std::vector<SDL_Surface*>& storage){
 
 	SDL_Rect tmpRect{ PINGUI_WINDOW_X, PINGUI_WINDOW_Y , PINGUI_WINDOW_W , PINGUI_WINDOW_H };
 
-    uploadSurface(tmpRect,sourceSurface);
+    uploadSurface(tmpRect,sourceSurface,storage);
 
-    loadWindowBorders(sourceSurface);
+    loadWindowBorders(sourceSurface,storage);
 }
 
-void SheetManager::loadWindowBorders(SDL_Surface*& sourceSurface){
+void SheetManager::loadWindowBorders(SDL_Surface*& sourceSurface, std::vector<SDL_Surface*>& storage){
 
 	SDL_Rect tmpRect{ PINGUI_WINDOW_LINE_X, PINGUI_WINDOW_LINE_Y, PINGUI_WINDOW_LINE_W, PINGUI_WINDOW_LINE_H };
 
-    uploadSurface(tmpRect,sourceSurface);
+    uploadSurface(tmpRect,sourceSurface,storage);
 
     tmpRect.w = 3;
     tmpRect.h = 3;
 
     tmpRect.x = PINGUI_WINDOW_TL_X;
     tmpRect.y = PINGUI_WINDOW_TL_Y;
-    uploadSurface(tmpRect,sourceSurface);
+    uploadSurface(tmpRect,sourceSurface,storage);
 
     tmpRect.x = PINGUI_WINDOW_BL_X;
     tmpRect.y = PINGUI_WINDOW_BL_Y;
-    uploadSurface(tmpRect,sourceSurface);
+    uploadSurface(tmpRect,sourceSurface,storage);
 
     tmpRect.x = PINGUI_WINDOW_TR_X;
     tmpRect.y = PINGUI_WINDOW_TR_Y;
-    uploadSurface(tmpRect,sourceSurface);
+    uploadSurface(tmpRect,sourceSurface,storage);
 
     tmpRect.x = PINGUI_WINDOW_BR_X;
     tmpRect.y = PINGUI_WINDOW_BR_Y;
-    uploadSurface(tmpRect,sourceSurface);
+    uploadSurface(tmpRect,sourceSurface,storage);
 }
 
 void SheetManager::addBackground(SDL_Surface*& target){
@@ -465,7 +528,7 @@ SDL_Surface* SheetManager::createWindow(int w, int h){
     return final_Surface;
 }
 
-void SheetManager::loadWindowScroller(SDL_Surface*& sourceSurface){
+void SheetManager::loadWindowScroller(SDL_Surface*& sourceSurface, std::vector<SDL_Surface*>& storage){
 
     SDL_Rect tmpRect;
 
@@ -475,12 +538,12 @@ void SheetManager::loadWindowScroller(SDL_Surface*& sourceSurface){
     //Inner part of scroller
     tmpRect.x = PINGUI_WINDOW_SCROLLER_INNER_X;
     tmpRect.y = PINGUI_WINDOW_SCROLLER_INNER_Y;
-    uploadSurface(tmpRect,sourceSurface);
+    uploadSurface(tmpRect,sourceSurface,storage);
 
     //Line
     tmpRect.x = PINGUI_WINDOW_SCROLLER_LINE_X;
     tmpRect.y = PINGUI_WINDOW_SCROLLER_LINE_Y;
-    uploadSurface(tmpRect,sourceSurface);
+    uploadSurface(tmpRect,sourceSurface,storage);
 
 }
 
@@ -598,36 +661,36 @@ void SheetManager::blitSurface(PinGUI::Rect tmpRect, surfaceType source, SDL_Sur
     SDL_BlitScaled(_SURFACES[source],NULL,dst,&TmpRect);
 }
 
-void SheetManager::loadWindowScrollerArrows(SDL_Surface*& sourceSurface){
+void SheetManager::loadWindowScrollerArrows(SDL_Surface*& sourceSurface, std::vector<SDL_Surface*>& storage){
 
 	SDL_Rect tmpRect{ PINGUI_WINDOW_SCROLLER_ARROW_UP_X ,
 					  PINGUI_WINDOW_SCROLLER_ARROW_UP_Y ,
 					  PINGUI_WINDOW_SCROLLER_ARROW_UPDOWN_W ,
 					  PINGUI_WINDOW_SCROLLER_ARROW_UPDOWN_H };
 
-    uploadSurface(tmpRect,sourceSurface);
+    uploadSurface(tmpRect,sourceSurface,storage);
 
     tmpRect.x = PINGUI_WINDOW_SCROLLER_ARROW_DOWN_X;
     tmpRect.y = PINGUI_WINDOW_SCROLLER_ARROW_DOWN_Y;
-    uploadSurface(tmpRect,sourceSurface);
+    uploadSurface(tmpRect,sourceSurface,storage);
 
     tmpRect.w = PINGUI_WINDOW_SCROLLER_ARROW_SIDE_W;
     tmpRect.h = PINGUI_WINDOW_SCROLLER_ARROW_SIDE_H;
 
     tmpRect.x = PINGUI_WINDOW_SCROLLER_ARROW_LEFT_X;
     tmpRect.y = PINGUI_WINDOW_SCROLLER_ARROW_LEFT_Y;
-    uploadSurface(tmpRect,sourceSurface);
+    uploadSurface(tmpRect,sourceSurface,storage);
 
     tmpRect.x = PINGUI_WINDOW_SCROLLER_ARROW_RIGHT_X;
     tmpRect.y = PINGUI_WINDOW_SCROLLER_ARROW_RIGHT_Y;
-    uploadSurface(tmpRect,sourceSurface);
+    uploadSurface(tmpRect,sourceSurface,storage);
 }
 
-void SheetManager::loadWindowScrollerFill(SDL_Surface*& sourceSurface){
+void SheetManager::loadWindowScrollerFill(SDL_Surface*& sourceSurface, std::vector<SDL_Surface*>& storage){
 
 	SDL_Rect tmpRect{ PINGUI_WINDOW_SCROLLER_FILL_X , PINGUI_WINDOW_SCROLLER_FILL_Y , 1, 1};
 
-    uploadSurface(tmpRect,sourceSurface);
+    uploadSurface(tmpRect,sourceSurface,storage);
 }
 
 void SheetManager::addRectangleBorders(SDL_Surface*& target, surfaceType line){
@@ -31,6 +31,11 @@
 
 #include "ErrorManager.h"
 #include "Input_Manager.h"
+#include "AssetPack.h"
+
+#define PINGUI_MAIN_SHEET_PATH "PinGUI/TextManager/Images/TextManagerSheet.png"
+
+#define PINGUI_WINDOW_SHEET_PATH "PinGUI/TextManager/Images/WindowSheet.png"
 
 /**
     This class is used for choosing different sprites for TextManager/PinGUI from the sheet
@@ -281,8 +286,15 @@ enum lineType{
 class SheetManager
 {
     private:
-        static std::vector<SDL_Surface*> _SURFACES;
+        static thread_local std::vector<SDL_Surface*> _SURFACES;
     public:
+        //Surfaces of one PinGUI::Context
+        struct contextState{
+            std::vector<SDL_Surface*> surfaces;
+        };
+
+        static void swapContext(contextState& state);
+
         /**
             Public Methods
         **/
@@ -308,13 +320,25 @@ class SheetManager
 
 		static SDL_Surface* loadCustomSurface(const std::string& filePath, bool checkResult = true);
 
-        static void loadSurface(enum surfaceType,SDL_Surface* wholeSurface);
+        static void loadSurface(enum surfaceType,SDL_Surface* wholeSurface, std::vector<SDL_Surface*>& storage = _SURFACES);
 
         static void loadAllTextures();
 
-        static void loadWindowTextures();
+        //Decodes and slices the sheets into the storage, false if the file can't be loaded
+        static bool loadMainSheet(std::vector<SDL_Surface*>& storage = _SURFACES);
+
+        static bool loadWindowTextures(std::vector<SDL_Surface*>& storage = _SURFACES);
+
+        //Wraps the sheet regions of the asset pack - no decoding, pixels stay in the mapped file
+        static bool loadFromPack(std::vector<SDL_Surface*>& storage = _SURFACES);
+
+        //Puts surfaces loaded into a separate storage (for example by a worker thread) behind the current ones
+        static void appendSurfaces(const std::vector<SDL_Surface*>& surfaces);
+
+        //Frees the sheet regions, the ones from the pack only drop their view of the mapping
+        static void freeSurfaces();
 
-        static void addToVector(SDL_Surface*);
+        static void addToVector(SDL_Surface*, std::vector<SDL_Surface*>& storage = _SURFACES);
 
         static SDL_Rect manageCroppedRect(surfaceType* type);
 
@@ -333,24 +357,24 @@ class SheetManager
         /**
             Elements stuff
         **/
-        static void loadComboBoxArrow(SDL_Surface*& sourceSurface);
+        static void loadComboBoxArrow(SDL_Surface*& sourceSurface, std::vector<SDL_Surface*>& storage = _SURFACES);
 
 
         /**
             Window stuff
         **/
-        static void loadWindow(SDL_Surface*& sourceSurface);
-        static void loadWindowTab(SDL_Surface*& sourceSurface);
-        static void loadWindowExitButton(SDL_Surface*& sourceSurface);
-        static void loadWindowBorders(SDL_Surface*& sourceSurface);
-        static void loadWindowScroller(SDL_Surface*& sourceSurface);
-        static void loadWindowScrollerArrows(SDL_Surface*& sourceSurface);
-        static void loadWindowScrollerFill(SDL_Surface*& sourceSurface);
+        static void loadWindow(SDL_Surface*& sourceSurface, std::vector<SDL_Surface*>& storage = _SURFACES);
+        static void loadWindowTab(SDL_Surface*& sourceSurface, std::vector<SDL_Surface*>& storage = _SURFACES);
+        static void loadWindowExitButton(SDL_Surface*& sourceSurface, std::vector<SDL_Surface*>& storage = _SURFACES);
+        static void loadWindowBorders(SDL_Surface*& sourceSurface, std::vector<SDL_Surface*>& storage = _SURFACES);
+        static void loadWindowScroller(SDL_Surface*& sourceSurface, std::vector<SDL_Surface*>& storage = _SURFACES);
+        static void loadWindowScrollerArrows(SDL_Surface*& sourceSurface, std::vector<SDL_Surface*>& storage = _SURFACES);
+        static void loadWindowScrollerFill(SDL_Surface*& sourceSurface, std::vector<SDL_Surface*>& storage = _SURFACES);
 
         static void addTabBackGround(SDL_Surface*& target);
         static void addTabLines(SDL_Surface*& target);
 
-        static void uploadSurface(SDL_Rect& cropRect, SDL_Surface* sourceSurface);
+        static void uploadSurface(SDL_Rect& cropRect, SDL_Surface* sourceSurface, std::vector<SDL_Surface*>& storage = _SURFACES);
 
         static SDL_Surface* getSurface(enum surfaceType);
 
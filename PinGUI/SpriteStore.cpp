@@ -0,0 +1,283 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "SpriteStore.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define PINGUI_SIMD_LANES 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define PINGUI_SIMD_LANES 4
+#else
+    #define PINGUI_SIMD_LANES 1
+#endif
+
+inline void addToAll(float* data, std::size_t count, float value){
+
+    std::size_t i = 0;
+
+#if PINGUI_SIMD_LANES == 8
+
+    __m256 add = _mm256_set1_ps(value);
+
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(data + i,_mm256_add_ps(_mm256_loadu_ps(data + i),add));
+
+#elif PINGUI_SIMD_LANES == 4
+
+    __m128 add = _mm_set1_ps(value);
+
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(data + i,_mm_add_ps(_mm_loadu_ps(data + i),add));
+
+#endif
+
+    for (; i < count; i++)
+        data[i] += value;
+}
+
+inline void fadeAll(const GLubyte* source, GLubyte* destination, std::size_t count, GLubyte fade){
+
+    std::size_t i = 0;
+
+    //Products are divided by 255 with rounding - (x + (x >> 8)) >> 8, where x is the product + 128
+
+#if PINGUI_SIMD_LANES == 8
+
+    __m256i zero = _mm256_setzero_si256();
+    __m256i factor = _mm256_set1_epi16(fade);
+    __m256i half = _mm256_set1_epi16(128);
+
+    for (; i + 32 <= count; i += 32){
+
+        __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+
+        __m256i low = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(values,zero),factor),half);
+        __m256i high = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(values,zero),factor),half);
+
+        low = _mm256_srli_epi16(_mm256_add_epi16(low,_mm256_srli_epi16(low,8)),8);
+        high = _mm256_srli_epi16(_mm256_add_epi16(high,_mm256_srli_epi16(high,8)),8);
+
+        //Unpacking and packing both work in 128 bit lanes, so the order stays
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i),_mm256_packus_epi16(low,high));
+    }
+
+#elif PINGUI_SIMD_LANES == 4
+
+    __m128i zero = _mm_setzero_si128();
+    __m128i factor = _mm_set1_epi16(fade);
+    __m128i half = _mm_set1_epi16(128);
+
+    for (; i + 16 <= count; i += 16){
+
+        __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+
+        __m128i low = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(values,zero),factor),half);
+        __m128i high = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(values,zero),factor),half);
+
+        low = _mm_srli_epi16(_mm_add_epi16(low,_mm_srli_epi16(low,8)),8);
+        high = _mm_srli_epi16(_mm_add_epi16(high,_mm_srli_epi16(high,8)),8);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i),_mm_packus_epi16(low,high));
+    }
+
+#endif
+
+    for (; i < count; i++){
+
+        unsigned int value = source[i] * fade + 128;
+
+        destination[i] = GLubyte((value + (value >> 8)) >> 8);
+    }
+}
+
+inline void extendRange(const float* data, std::size_t count, float& minValue, float& maxValue){
+
+    std::size_t i = 0;
+
+#if PINGUI_SIMD_LANES == 8
+
+    if (count >= 8){
+
+        __m256 low = _mm256_loadu_ps(data);
+        __m256 high = low;
+
+        for (i = 8; i + 8 <= count; i += 8){
+
+            __m256 values = _mm256_loadu_ps(data + i);
+
+            low = _mm256_min_ps(low,values);
+            high = _mm256_max_ps(high,values);
+        }
+
+        float lows[8], highs[8];
+
+        _mm256_storeu_ps(lows,low);
+        _mm256_storeu_ps(highs,high);
+
+        for (int j = 0; j < 8; j++){
+
+            minValue = std::min(minValue,lows[j]);
+            maxValue = std::max(maxValue,highs[j]);
+        }
+    }
+
+#elif PINGUI_SIMD_LANES == 4
+
+    if (count >= 4){
+
+        __m128 low = _mm_loadu_ps(data);
+        __m128 high = low;
+
+        for (i = 4; i + 4 <= count; i += 4){
+
+            __m128 values = _mm_loadu_ps(data + i);
+
+            low = _mm_min_ps(low,values);
+            high = _mm_max_ps(high,values);
+        }
+
+        float lows[4], highs[4];
+
+        _mm_storeu_ps(lows,low);
+        _mm_storeu_ps(highs,high);
+
+        for (int j = 0; j < 4; j++){
+
+            minValue = std::min(minValue,lows[j]);
+            maxValue = std::max(maxValue,highs[j]);
+        }
+    }
+
+#endif
+
+    for (; i < count; i++){
+
+        minValue = std::min(minValue,data[i]);
+        maxValue = std::max(maxValue,data[i]);
+    }
+}
+
+namespace PinGUI{
+
+    void SpriteStore::load(const vboData* quads, std::size_t count){
+
+        //Only resized, so it allocates just when the GUI grows
+        _X.resize(count*PINGUI_QUAD_VERTICES);
+        _Y.resize(count*PINGUI_QUAD_VERTICES);
+        _ALPHA.resize(count*PINGUI_QUAD_VERTICES);
+
+        _offsetX = 0.0f;
+        _offsetY = 0.0f;
+
+        for (std::size_t i = 0; i < count; i++){
+
+            for (int j = 0; j < PINGUI_QUAD_VERTICES; j++){
+
+                _X[i*PINGUI_QUAD_VERTICES + j] = quads[i].vertices[j].position.x;
+                _Y[i*PINGUI_QUAD_VERTICES + j] = quads[i].vertices[j].position.y;
+                _ALPHA[i*PINGUI_QUAD_VERTICES + j] = quads[i].vertices[j].color.a;
+            }
+        }
+    }
+
+    void SpriteStore::store(vboData* quads, std::size_t count, GLubyte fade){
+
+        count = std::min(count,getQuadCount());
+
+        const GLubyte* alphas = _ALPHA.data();
+
+        //Opaque fade keeps the alphas of the sprites
+        if (fade != 255){
+
+            _FADED.resize(_ALPHA.size());
+            fadeAll(_ALPHA.data(),_FADED.data(),_ALPHA.size(),fade);
+
+            alphas = _FADED.data();
+        }
+
+        //Vertex data are interleaved, so this pass is the only one that touches them
+        const float* xs = _X.data();
+        const float* ys = _Y.data();
+
+        for (std::size_t i = 0; i < count; i++){
+
+            for (int j = 0; j < PINGUI_QUAD_VERTICES; j++){
+
+                std::size_t k = i*PINGUI_QUAD_VERTICES + j;
+
+                quads[i].vertices[j].position.x = xs[k] + _offsetX;
+                quads[i].vertices[j].position.y = ys[k] + _offsetY;
+                quads[i].vertices[j].color.a = alphas[k];
+            }
+        }
+    }
+
+    void SpriteStore::translate(float x, float y){
+
+        _offsetX += x;
+        _offsetY += y;
+    }
+
+    void SpriteStore::translateRange(std::size_t first, std::size_t count, float x, float y){
+
+        if (first >= getQuadCount())
+            return;
+
+        count = std::min(count,getQuadCount() - first);
+
+        addToAll(_X.data() + first*PINGUI_QUAD_VERTICES,count*PINGUI_QUAD_VERTICES,x);
+        addToAll(_Y.data() + first*PINGUI_QUAD_VERTICES,count*PINGUI_QUAD_VERTICES,y);
+    }
+
+    void SpriteStore::extendBounds(float& minX, float& minY, float& maxX, float& maxY) const{
+
+        float lowX = FLT_MAX, lowY = FLT_MAX;
+        float highX = -FLT_MAX, highY = -FLT_MAX;
+
+        extendRange(_X.data(),_X.size(),lowX,highX);
+        extendRange(_Y.data(),_Y.size(),lowY,highY);
+
+        if (lowX > highX || lowY > highY)
+            return;
+
+        minX = std::min(minX,lowX + _offsetX);
+        maxX = std::max(maxX,highX + _offsetX);
+        minY = std::min(minY,lowY + _offsetY);
+        maxY = std::max(maxY,highY + _offsetY);
+    }
+
+    std::size_t SpriteStore::getQuadCount() const{
+        return _X.size() / PINGUI_QUAD_VERTICES;
+    }
+
+    int SpriteStore::getLaneCount(){
+        return PINGUI_SIMD_LANES;
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef SPRITESTORE_H
+#define SPRITESTORE_H
+
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include <vector>
+
+#include "stuff.h"
+
+namespace PinGUI{
+
+    /**
+        Cache of the vertex positions and alphas of the quads of one GUIManager, stored as separate arrays
+        It's refilled from the vertex data on every rebuild, between the rebuilds whole GUI moves and fades
+        are done here and written back in one pass instead of collecting the data from every sprite again
+        The corners of the quads carry their rects, the uvs stay in the vertex data - no bulk operation changes them
+    **/
+    class SpriteStore
+    {
+        private:
+
+            //4 entries for every quad, in the order of the vboData vertices
+            std::vector<float> _X;
+
+            std::vector<float> _Y;
+
+            //Alphas of the sprites and the faded ones written back
+            std::vector<GLubyte> _ALPHA;
+
+            std::vector<GLubyte> _FADED;
+
+            //Movement of all quads, added to the positions while they are written back
+            float _offsetX = 0.0f;
+
+            float _offsetY = 0.0f;
+
+        public:
+
+            //Splits the positions and alphas out of the quads
+            void load(const vboData* quads, std::size_t count);
+
+            //Writes the moved positions and the alphas faded by fade back, other attributes of the vertices stay
+            void store(vboData* quads, std::size_t count, GLubyte fade = 255);
+
+            //Only accumulates the movement, store applies it
+            void translate(float x, float y);
+
+            //Moves only the quads of one element
+            void translateRange(std::size_t first, std::size_t count, float x, float y);
+
+            //Grows the min and max by the stored positions
+            void extendBounds(float& minX, float& minY, float& maxX, float& maxY) const;
+
+            std::size_t getQuadCount() const;
+
+            //Floats in one instruction - 8 with AVX2, 4 with SSE2, 1 without them
+            static int getLaneCount();
+    };
+}
+
+#endif // SPRITESTORE_H
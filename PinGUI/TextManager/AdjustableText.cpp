@@ -29,7 +29,8 @@ AdjustableText::AdjustableText(std::string Text, PinGUI::Vector2<GUIPos> pos, te
 	_realTextSize(Size),
 	_realText(Text),
 	_fakeText(Text),
-	_maxRealTextSize(maxSize)
+	_maxRealTextSize(maxSize),
+	_windowStart(0)
 {
 }
 
@@ -79,8 +80,10 @@ void AdjustableText::adjustRealText(unsigned int afterLength) {
 	//Update the displayed part
 	text = _fakeText;
 
-	//Set the changed flag to true to alert the textmanager about change
-	changed = true;
+	//The displayed part only slides over the realText, the sprite slides over its glyphs the same way
+	shiftGlyphs(int(afterLength) - int(_windowStart));
+
+	_windowStart = afterLength;
 }
 
 void AdjustableText::endInputManipulation() {
@@ -94,6 +97,8 @@ void AdjustableText::endInputManipulation() {
 		addDots();
 
 		changed = true;
+
+		markDirty();
 	}
 }
 
@@ -110,6 +115,8 @@ void AdjustableText::startInputManipulation() {
 		text = _fakeText;
 
 		changed = true;
+
+		markDirty();
 	}
 }
 
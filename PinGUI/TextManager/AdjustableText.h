@@ -37,6 +37,9 @@ private:
 
 	unsigned int _maxRealTextSize;
 
+	//Position of the displayed part in the realText
+	unsigned int _windowStart;
+
 	/*
 		Private methods
 	*/
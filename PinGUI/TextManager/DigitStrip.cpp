@@ -0,0 +1,117 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "DigitStrip.h"
+
+#include <algorithm>
+
+#include "../AssetPack.h"
+
+DigitStrip::DigitStrip(textInfo* info):
+    _textureID(0),
+    _width(0),
+    _height(0)
+{
+    const char* chars = PINGUI_DIGIT_CHARS;
+
+    SDL_Surface* SURFACES[PINGUI_DIGIT_CHARS_COUNT];
+
+    for (int i = 0; i < PINGUI_DIGIT_CHARS_COUNT; i++){
+
+        char glyph[2] = {chars[i],'\0'};
+
+        //Prebaked glyphs of the pack first, SDL_ttf renders only what it doesn't have
+        SURFACES[i] = PinGUI::AssetPack::createGlyphSurface(info->fontSize,chars[i],info->color);
+
+        if (SURFACES[i]==nullptr)
+            SURFACES[i] = TTF_RenderText_Blended(info->font,glyph,info->color);
+
+        if (SURFACES[i]==nullptr){
+            std::cout << SDL_GetError() << std::endl;
+            ErrorManager::systemError("Cannot make a digit texture");
+        }
+
+        _ADVANCES[i] = 0;
+        TTF_GlyphMetrics(info->font,Uint16(chars[i]),nullptr,nullptr,nullptr,nullptr,&_ADVANCES[i]);
+
+        _X[i] = _width;
+        _W[i] = SURFACES[i]->w;
+
+        _width += SURFACES[i]->w + PINGUI_DIGIT_PADDING;
+        _height = std::max(_height,SURFACES[i]->h);
+    }
+
+    glGenTextures(1,&_textureID);
+
+    if (_textureID==0)
+        ErrorManager::systemError("Cannot generate digit texture!");
+
+    PinGUI::GL_StateManager::bindTexture(_textureID);
+
+    //Padding has to stay transparent
+    std::vector<Uint8> clear(std::size_t(_width) * std::size_t(_height) * 4,0);
+
+    glTexImage2D(GL_TEXTURE_2D,0,GL_RGBA,_width,_height,0,GL_RGBA,GL_UNSIGNED_BYTE,clear.data());
+
+    for (int i = 0; i < PINGUI_DIGIT_CHARS_COUNT; i++){
+
+        glPixelStorei(GL_UNPACK_ROW_LENGTH,SURFACES[i]->pitch / 4);
+        glTexSubImage2D(GL_TEXTURE_2D,0,_X[i],0,SURFACES[i]->w,SURFACES[i]->h,GL_RGBA,GL_UNSIGNED_BYTE,SURFACES[i]->pixels);
+
+        SDL_FreeSurface(SURFACES[i]);
+    }
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH,0);
+
+    //Wrapping
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_CLAMP_TO_EDGE);
+
+    //Filtering
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_NEAREST);
+
+    PinGUI::GL_StateManager::bindTexture(0);
+}
+
+DigitStrip::~DigitStrip()
+{
+    PinGUI::GL_StateManager::deleteTexture(_textureID);
+}
+
+int DigitStrip::getIndex(char ch){
+
+    if (ch >= '0' && ch <= '9')
+        return ch - '0';
+
+    switch (ch){
+        case '-' : return 10;
+        case '+' : return 11;
+        case '.' : return 12;
+        case ' ' : return 13;
+    }
+
+    return -1;
+}
@@ -0,0 +1,81 @@
+#ifndef DIGITSTRIP_H
+#define DIGITSTRIP_H
+
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "../GUI_Sprite.h"
+
+//Chars of numeric texts
+#define PINGUI_DIGIT_CHARS "0123456789-+. "
+
+#define PINGUI_DIGIT_CHARS_COUNT 14
+
+//Empty columns between the glyphs, so they don't bleed into each other
+#define PINGUI_DIGIT_PADDING 1
+
+/**
+    Texture with the glyphs of numeric texts of one font and color
+    Numeric texts are drawn as one quad per glyph pointing into it, so a new value
+    only rewrites the quads instead of rendering the text again
+**/
+class DigitStrip
+{
+    private:
+
+        GLuint _textureID;
+
+        int _width;
+
+        int _height;
+
+        //Position in the strip, width of the rendered glyph and pen advance
+        int _X[PINGUI_DIGIT_CHARS_COUNT];
+
+        int _W[PINGUI_DIGIT_CHARS_COUNT];
+
+        int _ADVANCES[PINGUI_DIGIT_CHARS_COUNT];
+
+    public:
+        DigitStrip(textInfo* info);
+        ~DigitStrip();
+
+        //Index of the glyph, -1 for chars that aren't in the strip
+        static int getIndex(char ch);
+
+        GLuint getTexture(){return _textureID;}
+
+        int getHeight(){return _height;}
+
+        int getGlyphWidth(int index){return _W[index];}
+
+        int getAdvance(int index){return _ADVANCES[index];}
+
+        float getU0(int index){return float(_X[index]) / float(_width);}
+
+        float getU1(int index){return float(_X[index] + _W[index]) / float(_width);}
+};
+
+#endif // DIGITSTRIP_H
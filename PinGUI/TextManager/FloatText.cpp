@@ -24,8 +24,8 @@
 
 **/
 
-#include <iomanip>
-#include <cstdlib>
+#include <cstring>
+#include <algorithm>
 
 FloatText::FloatText(PinGUI::Vector2<GUIPos> pos, textInfo* info, float* Variable):
     _variable(Variable),
@@ -42,7 +42,7 @@ FloatText::FloatText(PinGUI::Vector2<GUIPos> pos, textInfo* info, float* Variabl
 
     init(text,pos);
 
-    _sprite = std::make_shared<GUI_Sprite>(text,pos,info);
+    getNewDigits(info);
 }
 
 FloatText::~FloatText()
@@ -50,21 +50,27 @@ FloatText::~FloatText()
     //dtor
 }
 
-void FloatText::reloadString(){
+bool FloatText::reloadString(){
 
-    std::stringstream tmpString;
+    //Formatting on the stack, assign reuses the capacity of the text
+    char buffer[FLOAT_TEXT_BUFFER_SIZE];
 
-    tmpString << std::fixed << std::setprecision(FLOAT_TEXT_PRECISION) << *_variable;
+    auto result = std::to_chars(buffer,buffer + sizeof(buffer),double(*_variable),std::chars_format::fixed,FLOAT_TEXT_PRECISION);
 
-    text = tmpString.str();
+    if (result.ec != std::errc())
+        result.ptr = buffer;
+
+    return assignNumber(buffer,result.ptr);
 }
 
 void FloatText::needUpdate(textInfo* info, bool& update){
 
-    if ((*_variable != _last_var) || changed){
+    pollRaster(info,update);
+
+    if (changed || ((*_variable != _last_var) && _tmpInput)){
 
         if (_tmpInput)
-            _tmpFloat = float(std::atof(text.c_str()));
+            _tmpFloat = parseFloat(text);
 
         getNewText(info);
 
@@ -75,6 +81,21 @@ void FloatText::needUpdate(textInfo* info, bool& update){
         return;
     }
 
+    if (*_variable != _last_var){
+
+        _last_var = *_variable;
+
+        //Changes below the precision give the same digits, the sprite can stay
+        if (reloadString()){
+
+            getNewDigits(info);
+
+            update = true;
+
+            return;
+        }
+    }
+
     checkPositioned(update);
 }
 
@@ -96,12 +117,7 @@ void FloatText::getNewText(textInfo*& info){
     } else
         _tmpInput = false;
 
-    _sprite.reset();
-    _sprite = std::make_shared<GUI_Sprite>(text,_position,info);
-
-    if (_haveOffsetRect){
-        calculateTextPosition();
-    }
+    getNewDigits(info);
 }
 
 bool FloatText::findPoint(){
@@ -142,7 +158,7 @@ void FloatText::setChar(char ch, int pos){
 
     text[pos] = ch;
 
-    *_variable = float(std::atof(text.c_str()));
+    *_variable = parseFloat(text);
 
     changed = true;
 }
@@ -193,7 +209,9 @@ float FloatText::calculateAddition(char*& ch){
         return (getCharNum(ch) / divider);
     } else {
 
-        return (((float(std::atof(text.c_str())*10)) + getCharNum(ch)) - float(std::atof(text.c_str())));
+        float value = parseFloat(text);
+
+        return ((value * 10) + getCharNum(ch)) - value;
     }
 }
 
@@ -208,15 +226,19 @@ bool FloatText::checkCharAddition(char* ch, int& maxValue, int& minValue){
 
     if (_negative){
 
-        std::string tmpText(text);
-        tmpText.push_back(*ch);
+        char buffer[FLOAT_TEXT_BUFFER_SIZE];
+
+        std::size_t length = std::min(text.size(),sizeof(buffer) - 1);
 
-        if (std::atof(tmpText.c_str()) < minValue)
+        std::memcpy(buffer,text.data(),length);
+        buffer[length] = *ch;
+
+        if (parseFloat(buffer,buffer + length + 1) < minValue)
             return false;
 
     } else {
 
-        if (((std::atof(text.c_str()) + calculateAddition(ch) ) > maxValue))
+        if ((parseFloat(text) + calculateAddition(ch)) > maxValue)
             return false;
     }
 
@@ -269,6 +291,10 @@ void FloatText::turnOnNegative(){
 
 void FloatText::findNegative(){
 
-    if (std::atof(text.c_str())<0) _negative = true;
+    if (parseFloat(text)<0) _negative = true;
     else _negative = false;
 }
+
+bool FloatText::needsPolling(){
+    return true;
+}
\ No newline at end of file
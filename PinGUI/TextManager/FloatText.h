@@ -31,6 +31,8 @@
 
 #define FLOAT_TEXT_PRECISION 3
 
+#define FLOAT_TEXT_BUFFER_SIZE 64
+
 struct floatTextConstruction{
 
     int baseInt;
@@ -60,7 +62,8 @@ class FloatText: public Text
         /**
             Private methods
         **/
-        void reloadString();
+        //Returns whether the digits changed
+        bool reloadString();
 
         bool findPoint();
 
@@ -93,6 +96,9 @@ class FloatText: public Text
         void endInputManipulation() override;
 
         void turnOnNegative() override;
+
+        //Variable can change anytime
+        bool needsPolling() override;
 };
 
 #endif // FLOATTEXT_H
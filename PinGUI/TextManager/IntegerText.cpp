@@ -24,6 +24,9 @@
 
 **/
 
+#include <cstring>
+#include <algorithm>
+
 IntegerText::IntegerText(PinGUI::Vector2<GUIPos> pos, textInfo* info, int* Variable):
     _variable(Variable),
     _last_var(*Variable),
@@ -35,7 +38,7 @@ IntegerText::IntegerText(PinGUI::Vector2<GUIPos> pos, textInfo* info, int* Varia
 
     init(text,pos);
 
-    _sprite = std::make_shared<GUI_Sprite>(text,pos,info);
+    getNewDigits(info);
 }
 
 IntegerText::~IntegerText()
@@ -43,21 +46,24 @@ IntegerText::~IntegerText()
     //dtor
 }
 
-void IntegerText::reloadString(){
+bool IntegerText::reloadString(){
 
-    std::stringstream tmpString;
+    //Formatting on the stack, assign reuses the capacity of the text
+    char buffer[INTEGER_TEXT_BUFFER_SIZE];
 
-    tmpString << _last_var;
+    auto result = std::to_chars(buffer,buffer + sizeof(buffer),_last_var);
 
-    text = tmpString.str();
+    return assignNumber(buffer,result.ptr);
 }
 
 void IntegerText::needUpdate(textInfo* info, bool& update){
 
-    if ((*_variable != _last_var) || changed){
+    pollRaster(info,update);
+
+    if (changed || ((*_variable != _last_var) && _tmpInput)){
 
         if (_tmpInput)
-            _tmpInteger = std::atoi(text.c_str());
+            _tmpInteger = parseInt(text);
 
         getNewText(info);
 
@@ -68,6 +74,21 @@ void IntegerText::needUpdate(textInfo* info, bool& update){
         return;
     }
 
+    if (*_variable != _last_var){
+
+        _last_var = *_variable;
+
+        //Same digits, the sprite can stay
+        if (reloadString()){
+
+            getNewDigits(info);
+
+            update = true;
+
+            return;
+        }
+    }
+
     checkPositioned(update);
 }
 
@@ -88,12 +109,7 @@ void IntegerText::getNewText(textInfo*& info){
     } else
         _tmpInput = false;
 
-    _sprite.reset();
-    _sprite = std::make_shared<GUI_Sprite>(text,_position,info);
-
-    if (_haveOffsetRect){
-        calculateTextPosition();
-    }
+    getNewDigits(info);
 }
 
 void IntegerText::addChar(char* ch, bool change){
@@ -116,7 +132,7 @@ void IntegerText::setChar(char ch, int pos){
 
     text[pos] = ch;
 
-    *_variable = std::atoi(text.c_str());
+    *_variable = parseInt(text);
 
     changed = true;
 }
@@ -146,10 +162,14 @@ bool IntegerText::checkCharAddition(char* ch, int& maxValue, int& minValue){
 
     if (_negative){
 
-        std::string tmpText(text);
-        tmpText.push_back(*ch);
+        char buffer[INTEGER_TEXT_BUFFER_SIZE];
+
+        std::size_t length = std::min(text.size(),sizeof(buffer) - 1);
 
-        if (std::atoi(tmpText.c_str()) >= minValue)
+        std::memcpy(buffer,text.data(),length);
+        buffer[length] = *ch;
+
+        if (parseInt(buffer,buffer + length + 1) >= minValue)
             return true;
     } else {
         if ((getVariableNum()*10) + getCharNum(ch) <= maxValue) return true;
@@ -169,6 +189,10 @@ void IntegerText::turnOnNegative(){
 
 void IntegerText::findNegative(){
 
-    if (std::atof(text.c_str())<0) _negative = true;
+    if (parseInt(text)<0) _negative = true;
     else _negative = false;
 }
+
+bool IntegerText::needsPolling(){
+    return true;
+}
\ No newline at end of file
@@ -27,6 +27,9 @@
 
 #include "Text.h"
 
+//Longest int with its sign and one typed char
+#define INTEGER_TEXT_BUFFER_SIZE 16
+
 class IntegerText: public Text
 {
     private:
@@ -45,7 +48,8 @@ class IntegerText: public Text
         /**
             Private methods
         **/
-        void reloadString();
+        //Returns whether the digits changed
+        bool reloadString();
 
         void findNegative();
 
@@ -70,6 +74,9 @@ class IntegerText: public Text
         void endInputManipulation() override;
 
         void turnOnNegative() override;
+
+        //Variable can change anytime
+        bool needsPolling() override;
 };
 
 #endif // INTEGERTEXT_H
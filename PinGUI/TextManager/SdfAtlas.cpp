@@ -0,0 +1,181 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+
+#include "SdfAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../AssetPack.h"
+
+SdfAtlas::SdfAtlas(TTF_Font* font, int fontSize):
+    _textureID(0),
+    _width(0),
+    _lineHeight(0)
+{
+    SDL_Surface* SURFACES[PINGUI_SDF_CHARS_COUNT];
+
+    SDL_Color white = {255,255,255,255};
+
+    for (int i = 0; i < PINGUI_SDF_CHARS_COUNT; i++){
+
+        char ch = char(PINGUI_SDF_FIRST_CHAR + i);
+        char glyph[2] = {ch,'\0'};
+
+        //Coverage of the prebaked glyphs is enough for the field
+        SURFACES[i] = PinGUI::AssetPack::createGlyphSurface(fontSize,ch,white);
+
+        if (SURFACES[i]==nullptr)
+            SURFACES[i] = TTF_RenderText_Blended(font,glyph,white);
+
+        if (SURFACES[i]==nullptr){
+            std::cout << SDL_GetError() << std::endl;
+            ErrorManager::systemError("Cannot make an SDF glyph");
+        }
+
+        _ADVANCES[i] = 0;
+        TTF_GlyphMetrics(font,Uint16(ch),nullptr,nullptr,nullptr,nullptr,&_ADVANCES[i]);
+
+        _X[i] = _width;
+        _W[i] = SURFACES[i]->w;
+
+        _width += getCellWidth(i);
+        _lineHeight = std::max(_lineHeight,SURFACES[i]->h);
+    }
+
+    //One byte per pixel, cells don't touch anything outside the spread
+    std::vector<Uint8> field(std::size_t(_width) * std::size_t(getCellHeight()),0);
+
+    for (int i = 0; i < PINGUI_SDF_CHARS_COUNT; i++){
+
+        buildField(SURFACES[i],getCellWidth(i),getCellHeight(),field.data() + _X[i],_width);
+
+        SDL_FreeSurface(SURFACES[i]);
+    }
+
+    glGenTextures(1,&_textureID);
+
+    if (_textureID==0)
+        ErrorManager::systemError("Cannot generate SDF texture!");
+
+    PinGUI::GL_StateManager::bindTexture(_textureID);
+
+    //Rows of a single channel texture aren't aligned to 4 bytes
+    glPixelStorei(GL_UNPACK_ALIGNMENT,1);
+
+    glTexImage2D(GL_TEXTURE_2D,0,GL_R8,_width,getCellHeight(),0,GL_RED,GL_UNSIGNED_BYTE,field.data());
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT,4);
+
+    //Wrapping
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_CLAMP_TO_EDGE);
+
+    //Distances are interpolated, that's what keeps the scaled outline sharp
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+
+    PinGUI::GL_StateManager::bindTexture(0);
+}
+
+SdfAtlas::~SdfAtlas()
+{
+    PinGUI::GL_StateManager::deleteTexture(_textureID);
+}
+
+void SdfAtlas::buildField(SDL_Surface* glyph, int cellWidth, int cellHeight, Uint8* field, int fieldPitch){
+
+    const int spread = PINGUI_SDF_SPREAD;
+
+    //Coverage of the glyph moved by the spread, pixels outside the surface are empty
+    std::vector<char> inside(std::size_t(cellWidth) * std::size_t(cellHeight),0);
+
+    SDL_LockSurface(glyph);
+
+    for (int y = 0; y < glyph->h && y + spread < cellHeight; y++){
+
+        const Uint32* row = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(glyph->pixels) + y*glyph->pitch);
+
+        for (int x = 0; x < glyph->w && x + spread < cellWidth; x++){
+
+            Uint8 r, g, b, a;
+            SDL_GetRGBA(row[x],glyph->format,&r,&g,&b,&a);
+
+            inside[(y + spread)*cellWidth + x + spread] = (a >= 128);
+        }
+    }
+
+    SDL_UnlockSurface(glyph);
+
+    for (int y = 0; y < cellHeight; y++){
+
+        for (int x = 0; x < cellWidth; x++){
+
+            char state = inside[y*cellWidth + x];
+
+            //Nearest pixel on the other side of the outline, searched only within the spread
+            int nearest = (spread + 1) * (spread + 1);
+
+            for (int dy = -spread; dy <= spread; dy++){
+
+                int sy = y + dy;
+
+                if (sy < 0 || sy >= cellHeight)
+                    continue;
+
+                for (int dx = -spread; dx <= spread; dx++){
+
+                    int sx = x + dx;
+
+                    if (sx < 0 || sx >= cellWidth || inside[sy*cellWidth + sx] == state)
+                        continue;
+
+                    nearest = std::min(nearest,dx*dx + dy*dy);
+                }
+            }
+
+            //Outline runs between the two pixels
+            float distance = std::min(std::sqrt(float(nearest)),float(spread)) - 0.5f;
+
+            if (!state)
+                distance = -distance;
+
+            float value = 0.5f + 0.5f * distance / float(spread);
+
+            field[y*fieldPitch + x] = Uint8(std::lround(std::max(0.0f,std::min(1.0f,value)) * 255.0f));
+        }
+    }
+}
+
+int SdfAtlas::getIndex(char ch){
+
+    int code = static_cast<unsigned char>(ch);
+
+    if (code < PINGUI_SDF_FIRST_CHAR || code > PINGUI_SDF_LAST_CHAR)
+        return -1;
+
+    return code - PINGUI_SDF_FIRST_CHAR;
+}
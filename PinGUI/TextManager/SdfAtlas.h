@@ -0,0 +1,103 @@
+#ifndef SDFATLAS_H
+#define SDFATLAS_H
+
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+
+#include "../GUI_Sprite.h"
+
+//Glyphs are rendered at this size, texts of any size are scaled from it
+#define PINGUI_SDF_BASE_SIZE 32
+
+//Distance in pixels of the base size that the field covers on both sides of the outline
+#define PINGUI_SDF_SPREAD 4
+
+//Printable ASCII
+#define PINGUI_SDF_FIRST_CHAR 32
+
+#define PINGUI_SDF_LAST_CHAR 126
+
+#define PINGUI_SDF_CHARS_COUNT (PINGUI_SDF_LAST_CHAR - PINGUI_SDF_FIRST_CHAR + 1)
+
+/**
+    Signed distance fields of the glyphs of one font, in one strip like the DigitStrip
+    Texts are drawn as one quad per glyph with the SDF shader, so one atlas serves every font size
+    and a new size only scales the quads
+**/
+class SdfAtlas
+{
+    private:
+
+        GLuint _textureID;
+
+        int _width;
+
+        //Height of the line at the base size, cells have the spread on every side
+        int _lineHeight;
+
+        //Position of the cell in the strip, width of the rendered glyph and pen advance
+        int _X[PINGUI_SDF_CHARS_COUNT];
+
+        int _W[PINGUI_SDF_CHARS_COUNT];
+
+        int _ADVANCES[PINGUI_SDF_CHARS_COUNT];
+
+        /**
+            Private methods
+        **/
+
+        //Distance of every pixel of the cell to the outline, 128 is the outline
+        static void buildField(SDL_Surface* glyph, int cellWidth, int cellHeight, Uint8* field, int fieldPitch);
+
+    public:
+        //Font has to be opened at PINGUI_SDF_BASE_SIZE, it stays owned by the caller
+        //fontSize of the default font takes the glyphs from the asset pack, 0 renders all of them
+        SdfAtlas(TTF_Font* font, int fontSize = 0);
+        ~SdfAtlas();
+
+        //Index of the glyph, -1 for chars that aren't in the atlas
+        static int getIndex(char ch);
+
+        GLuint getTexture(){return _textureID;}
+
+        int getSpread(){return PINGUI_SDF_SPREAD;}
+
+        int getLineHeight(){return _lineHeight;}
+
+        int getCellHeight(){return _lineHeight + 2*PINGUI_SDF_SPREAD;}
+
+        int getGlyphWidth(int index){return _W[index];}
+
+        int getCellWidth(int index){return _W[index] + 2*PINGUI_SDF_SPREAD;}
+
+        int getAdvance(int index){return _ADVANCES[index];}
+
+        float getU0(int index){return float(_X[index]) / float(_width);}
+
+        float getU1(int index){return float(_X[index] + getCellWidth(index)) / float(_width);}
+};
+
+#endif // SDFATLAS_H
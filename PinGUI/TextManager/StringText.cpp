@@ -31,7 +31,8 @@ StringText::StringText(PinGUI::Vector2<GUIPos> pos, textInfo* info, std::string*
 
     init(text,pos);
 
-    _sprite = std::make_shared<GUI_Sprite>(text,pos,info);
+    if (!info->sdf || !layoutSdf(info))
+        _sprite = std::make_shared<GUI_Sprite>(text,pos,info);
 }
 
 StringText::~StringText()
@@ -41,16 +42,13 @@ StringText::~StringText()
 
 void StringText::reloadString(){
 
-    std::stringstream tmpString;
-
-    tmpString.str("");
-    tmpString << *_variable;
-
-    text = tmpString.str();
+    text.assign(*_variable);
 }
 
 void StringText::needUpdate(textInfo* info, bool& update){
 
+    pollRaster(info,update);
+
     if (changed){
 
         getNewText(info);
@@ -58,6 +56,16 @@ void StringText::needUpdate(textInfo* info, bool& update){
         update = true;
 
         changed = false;
+        _glyphEdit = false;
+
+        return;
+    }
+
+    if (_glyphEdit){
+
+        editGlyphs(info);
+
+        update = true;
 
         return;
     }
@@ -69,21 +77,14 @@ void StringText::getNewText(textInfo*& info){
 
     reloadString();
 
-    _sprite.reset();
-    _sprite = std::make_shared<GUI_Sprite>(text,_position,info);
-
-    if (_haveOffsetRect){
-        calculateTextPosition();
-    }
+    requestNewSprite(info);
 }
 
 void StringText::addChar(char* ch, bool change){
 
-    Text::addChar(ch);
+    Text::addChar(ch,change);
 
     *_variable = text;
-
-    changed = change;
 }
 
 void StringText::setChar(char ch, int pos){
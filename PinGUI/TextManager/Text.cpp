@@ -24,9 +24,14 @@
 
 #include "Text.h"
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
-Text::Text(){
-
+Text::Text():
+    _dirtyList(nullptr),
+    _queued(false),
+    _slot(0)
+{
 }
 
 Text::Text(std::string Text, PinGUI::Vector2<GUIPos> pos, textInfo* info):
@@ -37,12 +42,20 @@ Text::Text(std::string Text, PinGUI::Vector2<GUIPos> pos, textInfo* info):
     _haveOffsetRect(false),
     _networkedText(false),
     _show(true),
-    _position(pos)
+    _position(pos),
+    _glyphEdit(false),
+    _stableLength(0),
+    _glyphShift(0),
+    _digitCount(0),
+    _dirtyList(nullptr),
+    _queued(false),
+    _slot(0)
 {
     if (text.size()==0)
         text.push_back(' ');
 
-    _sprite = std::make_shared<GUI_Sprite>(text,pos,info);
+    if (!info->sdf || !layoutSdf(info))
+        _sprite = std::make_shared<GUI_Sprite>(text,pos,info);
 }
 
 Text::~Text()
@@ -57,18 +70,34 @@ void Text::init(std::string Text, PinGUI::Vector2<GUIPos> pos){
     _haveOffsetRect = false;
     _networkedText = false;
     _show = true;
+    _glyphEdit = false;
+    _stableLength = 0;
+    _glyphShift = 0;
+    _digitCount = 0;
 
     _position = pos;
 }
 
 void Text::needUpdate(textInfo* info, bool& update){
 
+    pollRaster(info,update);
+
     if (changed){
 
 		getNewText(info);
 
         update = true;
         changed = false;
+        _glyphEdit = false;
+
+        return;
+    }
+
+    if (_glyphEdit){
+
+        editGlyphs(info);
+
+        update = true;
 
         return;
     }
@@ -76,10 +105,81 @@ void Text::needUpdate(textInfo* info, bool& update){
     checkPositioned(update);
 }
 
+void Text::editGlyphs(textInfo* info){
+
+    //SDF quads are only laid out again
+    if (info->sdf && layoutSdf(info)){
+
+        _stableLength = text.size();
+        _glyphShift = 0;
+        _glyphEdit = false;
+
+        return;
+    }
+
+    //Sprite is older than the text the worker renders
+    bool stale = (_pendingRaster != nullptr);
+
+    _pendingRaster.reset();
+
+    long first = long(_sprite->getFirstGlyph()) + _glyphShift;
+
+    if (_digitCount > 0){
+
+        //Quads of the strip or the atlas can't take a rendered glyph
+        setNewSprite(info);
+
+    } else if (stale || !_sprite->isGlyphEditable() || first < 0 || std::size_t(first) + _stableLength > _sprite->getGlyphCount()){
+
+        //First edit of the text - from now on it has a texture with spare width
+        _sprite->rasterizeGlyphs(text,info);
+
+    } else {
+
+        _sprite->truncateGlyphs(std::size_t(first) + _stableLength);
+        _sprite->showGlyphsFrom(std::size_t(first));
+
+        for (std::size_t i = _stableLength; i < text.size(); i++){
+
+            if (!_sprite->appendGlyph(text[i],info)){
+
+                _sprite->rasterizeGlyphs(text,info);
+                break;
+            }
+        }
+    }
+
+    _stableLength = text.size();
+    _glyphShift = 0;
+    _glyphEdit = false;
+
+    if (_haveOffsetRect){
+        calculateTextPosition();
+    }
+}
+
+void Text::shiftGlyphs(int shift){
+
+    _glyphShift += shift;
+
+    if (shift > 0)
+        _stableLength = _stableLength > std::size_t(shift) ? _stableLength - shift : 0;
+    else
+        _stableLength = std::min(_stableLength + std::size_t(-shift),text.size());
+
+    _glyphEdit = true;
+
+    markDirty();
+}
+
 void Text::immediateChange(textInfo* info, bool& update) {
 
 	getNewText(info);
 
+	//Right now, not on a worker
+	if (_pendingRaster)
+		setNewSprite(info);
+
 	update = true;
 	changed = false;
 
@@ -98,6 +198,32 @@ void Text::checkPositioned(bool& update){
 }
 
 void Text::getNewText(textInfo*& info){
+    requestNewSprite(info);
+}
+
+void Text::requestNewSprite(textInfo* info){
+
+    //Nothing to render
+    if (info->sdf && layoutSdf(info))
+        return;
+
+    if (!info->rasterizer){
+
+        setNewSprite(info);
+        return;
+    }
+
+    //Replacing an unfinished request drops it
+    _pendingRaster = info->rasterizer->rasterize(text,info->color);
+}
+
+void Text::setNewSprite(textInfo* info){
+
+    _pendingRaster.reset();
+
+    _digitCount = 0;
+    _digits.reset();
+    _sdf.reset();
 
     _sprite.reset();
     _sprite = std::make_shared<GUI_Sprite>(text,_position,info);
@@ -107,11 +233,58 @@ void Text::getNewText(textInfo*& info){
     }
 }
 
+bool Text::pollRaster(textInfo* info, bool& update){
+
+    if (!_pendingRaster || !_pendingRaster->done.load(std::memory_order_acquire))
+        return false;
+
+    SDL_Surface* surface = _pendingRaster->surface;
+
+    _pendingRaster->surface = nullptr;
+    _pendingRaster.reset();
+
+    if (surface){
+
+        _digitCount = 0;
+        _digits.reset();
+        _sdf.reset();
+
+        //Sprite takes the surface over
+        _sprite = std::make_shared<GUI_Sprite>(_position,surface);
+
+        if (_haveOffsetRect){
+            calculateTextPosition();
+        }
+
+    } else {
+
+        //Worker couldn't render it, this reports the error
+        setNewSprite(info);
+    }
+
+    update = true;
+
+    return true;
+}
+
 void Text::replaceText(const std::string& newText){
 
     text = newText;
 
     changed = true;
+
+    markDirty();
+}
+
+void Text::reloadFont(textInfo* info){
+
+    //Same atlas - only the quads are scaled
+    if (_sdf && _sdf == info->sdf && layoutSdf(info))
+        return;
+
+    changed = true;
+
+    markDirty();
 }
 
 void Text::addChar(char* ch, bool change){
@@ -119,12 +292,18 @@ void Text::addChar(char* ch, bool change){
     if ((text[0]==' ' && text.size()==1)){
 
         text[0] = *ch;
+        _stableLength = 0;
     } else {
 
         text += *ch;
     }
 
-    changed  = change;
+    if (change){
+
+        _glyphEdit = true;
+
+        markDirty();
+    }
 }
 
 void Text::setChar(char ch, int pos){
@@ -132,26 +311,166 @@ void Text::setChar(char ch, int pos){
     text[pos] = ch;
 
     changed = true;
+
+    markDirty();
 }
 
 void Text::removeChar(){
 
     text.pop_back();
 
+    _stableLength = std::min(_stableLength,text.size());
+
     if (text.size() == 0)
         text.push_back(' ');
 
-    changed = true;
+    _glyphEdit = true;
+
+    markDirty();
+}
+
+bool Text::layoutDigits(textInfo* info){
+
+    for (std::size_t i = 0; i < text.size(); i++){
+
+        if (DigitStrip::getIndex(text[i]) < 0)
+            return false;
+    }
+
+    if (!info->digits)
+        info->digits = std::make_shared<DigitStrip>(info);
+
+    DigitStrip* strip = info->digits.get();
+
+    //Switching from a rendered sprite (or an older strip, or the SDF atlas) to this strip
+    if (_digits != info->digits){
+
+        _digits = info->digits;
+        _sdf.reset();
+
+        //Quads point into the previous texture
+        _DIGIT_SPRITES.clear();
+
+        _sprite = std::make_shared<GUI_Sprite>(PinGUI::Rect(_position.x,_position.y,0,strip->getHeight()),strip->getTexture(),0.0f,0.0f);
+    }
+
+    int pen = 0;
+    int width = 0;
+
+    for (std::size_t i = 0; i < text.size(); i++){
+
+        int index = DigitStrip::getIndex(text[i]);
+
+        //Sprites are kept for shorter values, so a changing length doesn't allocate
+        if (i >= _DIGIT_SPRITES.size())
+            _DIGIT_SPRITES.push_back(std::make_shared<GUI_Sprite>(PinGUI::Rect(0,0,0,0),strip->getTexture(),0.0f,0.0f));
+
+        PinGUI::Rect rect(_position.x + pen,_position.y,strip->getGlyphWidth(index),strip->getHeight());
+
+        _DIGIT_SPRITES[i]->setAtlasRect(rect,strip->getU0(index),strip->getU1(index));
+
+        width = std::max(width,pen + strip->getGlyphWidth(index));
+        pen += strip->getAdvance(index);
+    }
+
+    _digitCount = text.size();
+    _pendingRaster.reset();
+
+    _sprite->setAtlasRect(PinGUI::Rect(_position.x,_position.y,width,strip->getHeight()),0.0f,0.0f);
+
+    if (_haveOffsetRect){
+        calculateTextPosition();
+    }
+
+    return true;
+}
+
+void Text::getNewDigits(textInfo* info){
+
+    if (info->sdf && layoutSdf(info))
+        return;
+
+    if (!layoutDigits(info))
+        Text::getNewText(info);
+}
+
+bool Text::layoutSdf(textInfo* info){
+
+    for (std::size_t i = 0; i < text.size(); i++){
+
+        if (SdfAtlas::getIndex(text[i]) < 0)
+            return false;
+    }
+
+    SdfAtlas* atlas = info->sdf.get();
+    float scale = info->sdfScale;
+
+    int height = int(std::lround(atlas->getLineHeight() * scale));
+    int cellHeight = int(std::lround(atlas->getCellHeight() * scale));
+    float spread = atlas->getSpread() * scale;
+
+    //Switching from a rendered sprite (or the digit strip) to the atlas
+    if (_sdf != info->sdf){
+
+        _sdf = info->sdf;
+        _digits.reset();
+
+        //Quads point into the previous texture
+        _DIGIT_SPRITES.clear();
+
+        _sprite = std::make_shared<GUI_Sprite>(PinGUI::Rect(_position.x,_position.y,0,height),atlas->getTexture(),0.0f,0.0f);
+    }
+
+    float pen = 0.0f;
+    float width = 0.0f;
+
+    for (std::size_t i = 0; i < text.size(); i++){
+
+        int index = SdfAtlas::getIndex(text[i]);
+
+        if (i >= _DIGIT_SPRITES.size())
+            _DIGIT_SPRITES.push_back(std::make_shared<GUI_Sprite>(PinGUI::Rect(0,0,0,0),atlas->getTexture(),0.0f,0.0f));
+
+        //Cell has the spread around the glyph, the field fades out there
+        PinGUI::Rect rect(_position.x + pen - spread,_position.y - spread,int(std::lround(atlas->getCellWidth(index) * scale)),cellHeight);
+
+        _DIGIT_SPRITES[i]->setAtlasRect(rect,atlas->getU0(index),atlas->getU1(index));
+
+        //Atlas is white, the color comes from the vertices
+        _DIGIT_SPRITES[i]->changeColor(info->color);
+
+        width = std::max(width,pen + atlas->getGlyphWidth(index) * scale);
+        pen += atlas->getAdvance(index) * scale;
+    }
+
+    _digitCount = text.size();
+    _pendingRaster.reset();
+
+    _sprite->setAtlasRect(PinGUI::Rect(_position.x,_position.y,int(std::lround(width)),height),0.0f,0.0f);
+
+    if (_haveOffsetRect){
+        calculateTextPosition();
+    }
+
+    return true;
 }
 
 void Text::setPos(PinGUI::Vector2<GUIPos> setPos){
 
+    //Digit quads follow the text
+    PinGUI::Vector2<GUIPos> shift(setPos.x - _position.x,setPos.y - _position.y);
+
+    for (std::size_t i = 0; i < _digitCount; i++)
+        _DIGIT_SPRITES[i]->moveSprite(shift);
+
     _position.x = setPos.x;
     _position.y = setPos.y;
 
     _sprite->setPos(_position);
 
     positioned = true;
+
+    markDirty();
 }
 
 void Text::calculateTextPosition(){
@@ -182,9 +501,14 @@ void Text::moveText(const PinGUI::Vector2<GUIPos>& vect, bool croppedMovement){
     _sprite->moveSprite(vect);
     _position += vect;
 
+    for (std::size_t i = 0; i < _digitCount; i++)
+        _DIGIT_SPRITES[i]->moveSprite(vect);
+
     _offsetRect.addPos(vect);
 
     positioned = true;
+
+    markDirty();
 }
 
 void Text::moveTo(PinGUI::Vector2<GUIPos> vect){
@@ -244,6 +568,18 @@ std::shared_ptr<GUI_Sprite> Text::getSprite(){
     return _sprite;
 }
 
+std::size_t Text::getQuadCount(){
+    return _digitCount > 0 ? _digitCount : 1;
+}
+
+const std::shared_ptr<GUI_Sprite>& Text::getQuadSprite(std::size_t pos){
+    return _digitCount > 0 ? _DIGIT_SPRITES[pos] : _sprite;
+}
+
+bool Text::isSdf(){
+    return _sdf != nullptr;
+}
+
 bool Text::isActive(){
     return active;
 }
@@ -256,12 +592,58 @@ GUIPos Text::getY(){
     return _position.y;
 }
 
-std::string Text::getString(){
+const std::string& Text::getString(){
     return text;
 }
 
 void Text::setActive(bool state){
+
     active = state;
+
+    //TextManager removes it in the next update
+    if (!active)
+        markDirty();
+}
+
+void Text::setDirtyList(std::vector<Text*>* dirtyList, std::size_t slot){
+
+    _dirtyList = dirtyList;
+    _slot = slot;
+
+    if (!_dirtyList)
+        _queued = false;
+}
+
+void Text::markDirty(){
+
+    if (_queued || !_dirtyList)
+        return;
+
+    _queued = true;
+    _dirtyList->push_back(this);
+}
+
+void Text::dequeue(){
+    _queued = false;
+}
+
+std::size_t Text::getSlot(){
+    return _slot;
+}
+
+void Text::spriteChanged(){
+
+    positioned = true;
+
+    markDirty();
+}
+
+bool Text::needsPolling(){
+    return _pendingRaster != nullptr;
+}
+
+bool Text::rasterReady(){
+    return _pendingRaster && _pendingRaster->done.load(std::memory_order_acquire);
 }
 
 vboData Text::getVBOData(){
@@ -280,6 +662,46 @@ float Text::getCharNum(char* ch){
     return ((*ch)-48.0f);
 }
 
+float Text::parseFloat(const char* first, const char* last){
+
+    float result = 0.0f;
+
+    if (std::from_chars(first,last,result).ec != std::errc())
+        return 0.0f;
+
+    return result;
+}
+
+float Text::parseFloat(const std::string& str){
+    return parseFloat(str.data(),str.data() + str.size());
+}
+
+int Text::parseInt(const char* first, const char* last){
+
+    int result = 0;
+
+    if (std::from_chars(first,last,result).ec != std::errc())
+        return 0;
+
+    return result;
+}
+
+int Text::parseInt(const std::string& str){
+    return parseInt(str.data(),str.data() + str.size());
+}
+
+bool Text::assignNumber(const char* first, const char* last){
+
+    std::size_t length = std::size_t(last - first);
+
+    if (text.size() == length && text.compare(0,length,first,length) == 0)
+        return false;
+
+    text.assign(first,length);
+
+    return true;
+}
+
 bool Text::canAcceptNegativeInput(){
     if (text[0]==' ' && text.size()==1)
         return true;
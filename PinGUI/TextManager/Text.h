@@ -28,8 +28,12 @@
 #include <sstream>
 #include <cstdlib>
 #include <memory>
+#include <charconv>
 
 #include "../GUI_Sprite.h"
+#include "DigitStrip.h"
+#include "SdfAtlas.h"
+#include "TextRasterizer.h"
 
 #define EMPTY_TMP_INPUT -1
 
@@ -57,16 +61,80 @@ protected:
 
     bool _haveOffsetRect;
 
+    //Typing at the end only edits the glyphs of the sprite instead of rendering the whole text
+    bool _glyphEdit;
+
+    //Chars at the start of the text that are still in the sprite since the last edit
+    std::size_t _stableLength;
+
+    //Shift of the first shown glyph of the sprite since the last edit
+    int _glyphShift;
+
+    //Numeric and SDF texts - one quad per char pointing into the digit strip or the SDF atlas, _sprite only spans them
+    std::vector<std::shared_ptr<GUI_Sprite>> _DIGIT_SPRITES;
+
+    std::size_t _digitCount;
+
+    std::shared_ptr<DigitStrip> _digits;
+
+    std::shared_ptr<SdfAtlas> _sdf;
+
+    //Sprite of the changed text being rendered by a worker, the old one is shown till then
+    std::shared_ptr<rasterRequest> _pendingRaster;
+
+    //Dirty list of the TextManager - changed texts put themselves there instead of being checked every frame
+    std::vector<Text*>* _dirtyList;
+
+    bool _queued;
+
+    //Position in the TextManager, its quads are written only at this slot
+    std::size_t _slot;
+
     /**
         Private methods
     **/
 
     void checkPositioned(bool& update);
 
+    void editGlyphs(textInfo* info);
+
+    //Text now starts shift chars later (or sooner) in the glyphs of the sprite
+    void shiftGlyphs(int shift);
+
     void init(std::string Text, PinGUI::Vector2<GUIPos> pos);
 
     float getCharNum(char* ch);
 
+    //Numbers are parsed without allocating, text that isn't a number gives 0
+    static float parseFloat(const char* first, const char* last);
+
+    static float parseFloat(const std::string& str);
+
+    static int parseInt(const char* first, const char* last);
+
+    static int parseInt(const std::string& str);
+
+    //Replaces the text only if the formatted number differs, returns whether it did
+    bool assignNumber(const char* first, const char* last);
+
+    //Lays the text out from the digit strip, false if it has a char the strip doesn't have
+    bool layoutDigits(textInfo* info);
+
+    //Digit layout, or a rendered sprite for texts the strip can't show
+    void getNewDigits(textInfo* info);
+
+    //Lays the text out from the SDF atlas at its scale, false if it has a char the atlas doesn't have
+    bool layoutSdf(textInfo* info);
+
+    //Sprite of the text rendered on a worker, or right away without a rasterizer
+    void requestNewSprite(textInfo* info);
+
+    void setNewSprite(textInfo* info);
+
+    //Takes the sprite done by the worker, returns whether there was one
+    bool pollRaster(textInfo* info, bool& update);
+
+
 public:
     Text();
     Text(std::string Text, PinGUI::Vector2<GUIPos> pos, textInfo* info);
@@ -91,6 +159,12 @@ public:
 
     virtual bool isZero();
 
+    //Texts following a variable or waiting for a worker are checked every frame
+    virtual bool needsPolling();
+
+    //Worker finished the sprite, it only waits for its texture
+    bool rasterReady();
+
     virtual void endInputManipulation(){};
 
 	virtual void startInputManipulation() {};
@@ -105,8 +179,19 @@ public:
 
     void replaceText(const std::string& newText);
 
+    //Font size or text mode changed - SDF texts only scale their quads, the rest is rendered again
+    void reloadFont(textInfo* info);
+
     std::shared_ptr<GUI_Sprite> getSprite();
 
+    //Quads the text is drawn with - one for rendered texts, one per char for the digit layout
+    std::size_t getQuadCount();
+
+    const std::shared_ptr<GUI_Sprite>& getQuadSprite(std::size_t pos);
+
+    //Quads are distance fields, drawn with the SDF program
+    bool isSdf();
+
     bool canAcceptNegativeInput();
 
     bool isActive();
@@ -115,10 +200,24 @@ public:
 
     GUIPos getY();
 
-    std::string getString();
+    const std::string& getString();
 
     void setActive(bool state);
 
+    //Set by the TextManager, nullptr once the text is removed from it
+    void setDirtyList(std::vector<Text*>* dirtyList, std::size_t slot);
+
+    //Queues the text for the next update of the TextManager
+    void markDirty();
+
+    //TextManager takes the text off its dirty list
+    void dequeue();
+
+    std::size_t getSlot();
+
+    //Sprite was changed from outside (cropped by its element), its quads have to be written again
+    void spriteChanged();
+
     vboData getVBOData();
 
     bool isPositioned();
@@ -24,27 +24,45 @@
 
 #include "TextManager.h"
 #include <iostream>
+#include <fstream>
+
+std::map<std::string, fontFileData> TextManager::_FONT_FILES;
+
+std::mutex TextManager::_fontMutex;
 
 TextManager::TextManager():
     _needUpdate(false),
-    _moved(false)
+    _moved(false),
+    _needRebuild(false),
+    _needUpload(false),
+    _asyncRaster(true),
+    _rebuildAll(true),
+    _uploadAll(true),
+    _revision(0)
 {
     _fontSize = 14;
 
-    _textVBOManager = std::make_shared<VBO_Manager>(40,true);
+    _textVBOManager = std::make_shared<VBO_Manager>(40,true,true);
 
     //Loading all the stuff
     loadTextInfo();
 }
 
 TextManager::TextManager(const TextManager& txt):
-    _needUpdate(txt._needUpdate),
-    _moved(txt._moved),
+    _TEXTS(txt._TEXTS),
+    _mainDataStorage(txt._mainDataStorage),
+    _FIRST_QUADS(txt._FIRST_QUADS),
+    _textVBOManager(txt._textVBOManager),
     _fontSize(txt._fontSize),
     _mainTextInfo(txt._mainTextInfo),
-    _textVBOManager(txt._textVBOManager),
-    _mainDataStorage(txt._mainDataStorage),
-    _TEXTS(txt._TEXTS),
+    _needUpdate(txt._needUpdate),
+    _moved(txt._moved),
+    _needRebuild(txt._needRebuild),
+    _needUpload(txt._needUpload),
+    _asyncRaster(txt._asyncRaster),
+    _rebuildAll(true),
+    _uploadAll(true),
+    _revision(txt._revision),
     _function(txt._function)
 {
 }
@@ -52,90 +70,139 @@ TextManager::TextManager(const TextManager& txt):
 
 TextManager::~TextManager()
 {
+    //Texts can outlive the manager in their storages
+    for (std::size_t i = 0; i < _TEXTS.size(); i++)
+        _TEXTS[i]->setDirtyList(nullptr,0);
+
     _TEXTS.clear();
 }
 
-std::shared_ptr<Text> TextManager::writeText(const std::string& text,GUIPos x, GUIPos y){
+std::shared_ptr<Text> TextManager::addText(std::shared_ptr<Text> text){
 
-    PinGUI::Vector2<GUIPos> tmpVecc(x,y);
+    text->setDirtyList(&_DIRTY_TEXTS,_TEXTS.size());
 
-    auto ptr = std::make_shared<Text>(text,tmpVecc,&_mainTextInfo);
-    _TEXTS.push_back(ptr);
+    _TEXTS.push_back(text);
+
+    //First check - numeric texts stay on the list from then on
+    text->markDirty();
 
     _needUpdate = true;
+    _rebuildAll = true;
 
     return _TEXTS.back();
 }
 
-std::shared_ptr<Text> TextManager::writeAdjustableText(const std::string& text, GUIPos x, GUIPos y, unsigned int size, unsigned int maxSize) {
+std::shared_ptr<Text> TextManager::writeText(const std::string& text,GUIPos x, GUIPos y){
 
-	PinGUI::Vector2<GUIPos> tmpVecc(x, y);
+    PinGUI::Vector2<GUIPos> tmpVecc(x,y);
+
+    return addText(std::make_shared<Text>(text,tmpVecc,&_mainTextInfo));
+}
 
-	auto ptr = std::make_shared<AdjustableText>(text, tmpVecc, &_mainTextInfo, size, maxSize);
-	_TEXTS.push_back(ptr);
+std::shared_ptr<Text> TextManager::writeAdjustableText(const std::string& text, GUIPos x, GUIPos y, unsigned int size, unsigned int maxSize) {
 
-	_needUpdate = true;
+	PinGUI::Vector2<GUIPos> tmpVecc(x, y);
 
-	return _TEXTS.back();
+	return addText(std::make_shared<AdjustableText>(text, tmpVecc, &_mainTextInfo, size, maxSize));
 }
 
 std::shared_ptr<Text> TextManager::writeText(GUIPos x, GUIPos y, int* var){
 
     PinGUI::Vector2<GUIPos> tmpVecc(x,y);
 
-    auto ptr = std::make_shared<IntegerText>(tmpVecc,&_mainTextInfo,var);
-    _TEXTS.push_back(ptr);
-
-    _needUpdate = true;
-
-    return _TEXTS.back();
+    return addText(std::make_shared<IntegerText>(tmpVecc,&_mainTextInfo,var));
 }
 
 std::shared_ptr<Text> TextManager::writeText(GUIPos x, GUIPos y, float* var){
 
     PinGUI::Vector2<GUIPos> tmpVecc(x,y);
 
-    auto ptr = std::make_shared<FloatText>(tmpVecc,&_mainTextInfo,var);
-    _TEXTS.push_back(ptr);
-
-    _needUpdate = true;
-
-    return _TEXTS.back();
+    return addText(std::make_shared<FloatText>(tmpVecc,&_mainTextInfo,var));
 }
 
 std::shared_ptr<Text> TextManager::writeText(GUIPos x, GUIPos y, std::string* var){
 
     PinGUI::Vector2<GUIPos> tmpVecc(x,y);
 
-    auto ptr = std::make_shared<StringText>(tmpVecc,&_mainTextInfo,var);
-    _TEXTS.push_back(ptr);
-
-    _needUpdate = true;
-
-    return _TEXTS.back();
+    return addText(std::make_shared<StringText>(tmpVecc,&_mainTextInfo,var));
 }
 
 void TextManager::renderText(){
 
-    glBindVertexArray(_textVBOManager->getVAO());
+    upload();
+
+    _textVBOManager->bind();
+
+    //Texts the atlas couldn't show are rendered sprites even in the SDF mode
+    bool sdfProgram = false;
+
+    //Neighbouring quads with the same texture are drawn by one call
+    std::size_t runFirst = 0, runCount = 0;
+    GLuint runTexture = 0;
+
+    auto drawRun = [&](){
+
+        if (runCount == 0)
+            return;
+
+        PinGUI::GL_StateManager::bindTexture(runTexture);
+
+        VBO_Manager::drawQuads(int(runFirst),int(runCount));
+
+        runCount = 0;
+    };
+
+    for (std::size_t i=0; i < _TEXTS.size() && i + 1 < _FIRST_QUADS.size();i++){
+
+        if (!_TEXTS[i]->getShow())
+            continue;
+
+        if (_TEXTS[i]->isSdf() != sdfProgram){
 
-    for (GLuint i=0; i < _TEXTS.size();i++){
+            drawRun();
 
-        if (_TEXTS[i]->getShow()){
+            sdfProgram = !sdfProgram;
 
-            //Binding the texture
-            glBindTexture(GL_TEXTURE_2D,_TEXTS[i]->getSprite()->getTexture());
+            if (sdfProgram)
+                PinGUI::Shader_Program::beginSdf();
+            else
+                PinGUI::Shader_Program::endSdf();
+        }
+
+        std::size_t quad = _FIRST_QUADS[i];
+
+        for (std::size_t j = 0; j < _TEXTS[i]->getQuadCount(); j++){
+
+            const std::shared_ptr<GUI_Sprite>& sprite = _TEXTS[i]->getQuadSprite(j);
+
+            //Culled texts were cropped away by the window camera
+            if (sprite->isCulled())
+                continue;
+
+            //Atlas texts and digit quads share the texture, so their runs get long
+            if (runCount > 0 && (sprite->getTexture() != runTexture || runFirst + runCount != quad + j))
+                drawRun();
+
+            if (runCount == 0){
+
+                runFirst = quad + j;
+                runTexture = sprite->getTexture();
+            }
 
-            //Draw it
-            glDrawArrays(GL_TRIANGLES,i*6,6);
+            runCount++;
         }
     }
 
-    glBindVertexArray(0);
+    drawRun();
+
+    if (sdfProgram)
+        PinGUI::Shader_Program::endSdf();
 }
 
 void TextManager::updateText(){
 
+    PinGUI::AllocationScope allocationScope(PinGUI::ALLOC_TEXT);
+
     checkForUpdate();
 
     if (_needUpdate){
@@ -147,17 +214,114 @@ void TextManager::updateText(){
             _moved = false;
         }
 
-        //Here is the action that is affected by stuff
-        updateVBOData();
+        //Vertex data are built in prepareRender, possibly on a worker
         _needUpdate = false;
-        loadVBO();
+        _needRebuild = true;
+    }
+}
+
+bool TextManager::needPrepare(){
+    return _needRebuild;
+}
+
+void TextManager::upload(){
+
+    //Nothing happens here in case PINGUI::render already prepared the data on the workers
+    prepareRender();
+
+    if (!_needUpload)
+        return;
+
+    _needUpload = false;
+    _revision++;
+
+    if (PinGUI::DamageTracker::isEnabled()){
+
+        PinGUI::DamageTracker::addChanges(_uploadedData,_mainDataStorage);
+
+        //Texture of the text changed, the quad alone may stay the same
+        for (std::size_t i = 0; i < _CHANGED_TEXTS.size(); i++){
+
+            std::size_t index = _CHANGED_TEXTS[i];
+
+            addTextDamage(_uploadedData,_uploadedFirstQuads,index);
+            addTextDamage(_mainDataStorage,_FIRST_QUADS,index);
+        }
+
+        _uploadedData = _mainDataStorage;
+        _uploadedFirstQuads = _FIRST_QUADS;
+    }
+
+    _CHANGED_TEXTS.clear();
+
+    loadVBO();
+}
+
+void TextManager::refresh(){
+
+    upload();
+
+    _drawnShown.resize(_TEXTS.size(),0);
+
+    for (std::size_t i = 0; i < _TEXTS.size(); i++){
+
+        char shown = _TEXTS[i]->getShow();
+
+        if (_drawnShown[i] != shown){
+
+            _drawnShown[i] = shown;
+            _revision++;
+
+            addTextDamage(_mainDataStorage,_FIRST_QUADS,i);
+        }
+    }
+}
+
+void TextManager::addTextDamage(const std::vector<vboData>& data, const std::vector<std::size_t>& firstQuads, std::size_t text){
+
+    if (text + 1 >= firstQuads.size())
+        return;
+
+    for (std::size_t i = firstQuads[text]; i < firstQuads[text+1] && i < data.size(); i++)
+        PinGUI::DamageTracker::addQuad(data[i]);
+}
+
+uint64_t TextManager::getRevision(){
+    return _revision;
+}
+
+const std::vector<vboData>& TextManager::getVertexData(){
+    return _mainDataStorage;
+}
+
+void TextManager::prepareRender(){
+
+    std::lock_guard<std::mutex> lock(_prepareMutex);
+
+    if (_needRebuild){
+
+        PinGUI::AllocationScope allocationScope(PinGUI::ALLOC_TEXT);
+
+        updateVBOData();
+        _needRebuild = false;
+        _needUpload = true;
     }
 }
 
 TTF_Font* TextManager::loadFont(const std::string& fontPath, int size){
 
     TTF_Font* tmp = nullptr;
-    tmp = TTF_OpenFont(fontPath.c_str(),size);
+
+    {
+        std::lock_guard<std::mutex> lock(_fontMutex);
+
+        auto it = _FONT_FILES.find(fontPath);
+
+        if (it != _FONT_FILES.end())
+            tmp = TTF_OpenFontRW(SDL_RWFromConstMem(it->second.data,int(it->second.size)),1,size);
+        else
+            tmp = TTF_OpenFont(fontPath.c_str(),size);
+    }
 
     if (tmp==nullptr){
         ErrorManager::fileError(fontPath);
@@ -166,18 +330,110 @@ TTF_Font* TextManager::loadFont(const std::string& fontPath, int size){
     return tmp;
 }
 
+bool TextManager::preloadFont(const std::string& fontPath){
+
+    {
+        std::lock_guard<std::mutex> lock(_fontMutex);
+
+        //Another context already loaded it and its fonts read from that memory
+        if (_FONT_FILES.count(fontPath))
+            return true;
+    }
+
+    std::ifstream fontFile(fontPath, std::ios::binary | std::ios::ate);
+
+    if (fontFile.fail())
+        return false;
+
+    std::streamsize size = fontFile.tellg();
+    fontFile.seekg(0,std::ios::beg);
+
+    std::vector<char> data(static_cast<std::size_t>(size));
+
+    if (!fontFile.read(data.data(),size))
+        return false;
+
+    std::lock_guard<std::mutex> lock(_fontMutex);
+
+    if (_FONT_FILES.count(fontPath))
+        return true;
+
+    fontFileData& font = _FONT_FILES[fontPath];
+
+    font.storage = std::move(data);
+    font.data = font.storage.data();
+    font.size = font.storage.size();
+
+    return true;
+}
+
+void TextManager::registerFont(const std::string& fontPath, const char* data, std::size_t size){
+
+    std::lock_guard<std::mutex> lock(_fontMutex);
+
+    //Already opened fonts keep reading from the current data
+    if (_FONT_FILES.count(fontPath))
+        return;
+
+    fontFileData& font = _FONT_FILES[fontPath];
+
+    font.storage.clear();
+    font.data = data;
+    font.size = size;
+}
+
+void TextManager::releaseFont(const std::string& fontPath){
+
+    std::lock_guard<std::mutex> lock(_fontMutex);
+
+    _FONT_FILES.erase(fontPath);
+}
+
 void TextManager::setColor(GLubyte R, GLubyte G, GLubyte B, GLubyte A){
 
     _mainTextInfo.color.r = R;
     _mainTextInfo.color.g = G;
     _mainTextInfo.color.b = B;
     _mainTextInfo.color.a = A;
+
+    //Numeric texts written from now on use the new color
+    _mainTextInfo.digits.reset();
 }
 
 void TextManager::loadVBO(){
 
-    if (_textVBOManager->bufferData(0,_mainDataStorage))
-        _needUpdate = true;
+    if (_uploadAll){
+
+        _uploadAll = false;
+        _UPLOAD_SLOTS.clear();
+
+        if (_textVBOManager->bufferData(0,_mainDataStorage)){
+            _needUpdate = true;
+            _rebuildAll = true;
+        }
+
+        return;
+    }
+
+    //Neighbouring texts go in one upload
+    std::size_t i = 0;
+
+    while (i < _UPLOAD_SLOTS.size()){
+
+        std::size_t first = _UPLOAD_SLOTS[i];
+        std::size_t last = first;
+
+        while (i + 1 < _UPLOAD_SLOTS.size() && _UPLOAD_SLOTS[i+1] == last + 1)
+            last = _UPLOAD_SLOTS[++i];
+
+        i++;
+
+        std::size_t firstQuad = _FIRST_QUADS[first];
+
+        _textVBOManager->bufferData(int(firstQuad),_mainDataStorage.data() + firstQuad,int(_FIRST_QUADS[last+1] - firstQuad));
+    }
+
+    _UPLOAD_SLOTS.clear();
 }
 
 void TextManager::loadTextInfo(){
@@ -191,33 +447,160 @@ void TextManager::loadTextInfo(){
     tmp.a = 255;
 
     _mainTextInfo.color = tmp;
-    _mainTextInfo.font = loadFont("PinGUI/TextManager/Fonts/Oswald-Light.ttf",_fontSize);
+    _mainTextInfo.font = loadFont(PINGUI_DEFAULT_FONT_PATH,_fontSize);
+    _mainTextInfo.fontSize = _fontSize;
+    _mainTextInfo.digits.reset();
+
+    loadRasterizer();
+}
+
+void TextManager::loadRasterizer(){
+
+    _mainTextInfo.rasterizer.reset();
+
+    //Second instance of the font for the workers
+    if (_asyncRaster)
+        _mainTextInfo.rasterizer = std::make_shared<TextRasterizer>(loadFont(PINGUI_DEFAULT_FONT_PATH,_fontSize));
 }
 
-void TextManager::removeData(std::size_t& position){
+void TextManager::setSdfRendering(bool state){
+
+    if (state == isSdfRendering())
+        return;
+
+    if (state){
 
-	if (_TEXTS.size()>0)
-		_TEXTS.erase(_TEXTS.begin()+position);
+        //Atlas is built from its own instance of the font, at the base size
+        TTF_Font* font = loadFont(PINGUI_DEFAULT_FONT_PATH,PINGUI_SDF_BASE_SIZE);
 
-	if (_mainDataStorage.size()>0)
-		_mainDataStorage.erase(_mainDataStorage.begin()+position);
+        _mainTextInfo.sdf = std::make_shared<SdfAtlas>(font,PINGUI_SDF_BASE_SIZE);
+        _mainTextInfo.sdfScale = float(_fontSize) / float(PINGUI_SDF_BASE_SIZE);
+
+        TTF_CloseFont(font);
+
+    } else {
+
+        _mainTextInfo.sdf.reset();
+    }
+
+    reloadTexts();
+}
+
+bool TextManager::isSdfRendering(){
+    return _mainTextInfo.sdf != nullptr;
+}
+
+void TextManager::reloadTexts(){
+
+    for (std::size_t i = 0; i < _TEXTS.size(); i++)
+        _TEXTS[i]->reloadFont(&_mainTextInfo);
 
     _needUpdate = true;
+    _rebuildAll = true;
+}
+
+void TextManager::setAsyncRasterization(bool state){
+
+    if (_asyncRaster == state)
+        return;
+
+    _asyncRaster = state;
+
+    loadRasterizer();
+}
+
+void TextManager::removeInactiveTexts(){
+
+    //One pass, the remaining texts move to their new slots
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < _TEXTS.size(); i++){
+
+        if (!_TEXTS[i]->isActive()){
+
+            _TEXTS[i]->setDirtyList(nullptr,0);
+            continue;
+        }
+
+        _TEXTS[i]->setDirtyList(&_DIRTY_TEXTS,count);
+        _TEXTS[count++] = _TEXTS[i];
+    }
+
+    _TEXTS.resize(count);
+
+    _needUpdate = true;
+    _rebuildAll = true;
 }
 
 void TextManager::checkForUpdate(){
 
-    for (std::size_t i=0; i <_TEXTS.size();i++){
+    //Texts can queue themselves again while they're checked
+    _CHECKED_TEXTS.swap(_DIRTY_TEXTS);
+
+    bool removed = false;
+
+    for (std::size_t i = 0; i < _CHECKED_TEXTS.size(); i++){
+
+        _CHECKED_TEXTS[i]->dequeue();
+
+        if (!_CHECKED_TEXTS[i]->isActive())
+            removed = true;
+    }
+
+    //Removed before the checks, so the slots don't move under them
+    if (removed){
 
-        if ( _TEXTS[i] && _TEXTS[i]->isActive()){
+        _CHECKED_TEXTS.erase(std::remove_if(_CHECKED_TEXTS.begin(),_CHECKED_TEXTS.end(),
+                                            [](Text* text){return !text->isActive();}),_CHECKED_TEXTS.end());
+        removeInactiveTexts();
+    }
+
+    int uploads = 0;
+
+    for (std::size_t i = 0; i < _CHECKED_TEXTS.size(); i++){
+
+        Text* text = _CHECKED_TEXTS[i];
+
+        //Every finished raster creates a texture, a burst of them is spread over frames
+        if (text->rasterReady() && uploads++ >= PINGUI_TEXT_UPLOADS_PER_FRAME){
+
+            text->markDirty();
+            continue;
+        }
+
+        bool changed = false;
 
-            _TEXTS[i]->needUpdate(&_mainTextInfo,_needUpdate);
-        } else {
+        text->needUpdate(&_mainTextInfo,changed);
 
-            removeData(i);
-            i--;
+        if (changed){
+
+            _needUpdate = true;
+
+            _DIRTY_SLOTS.push_back(text->getSlot());
+
+            if (PinGUI::DamageTracker::isEnabled())
+                _CHANGED_TEXTS.push_back(text->getSlot());
         }
+
+        if (text->needsPolling())
+            text->markDirty();
+    }
+
+    _CHECKED_TEXTS.clear();
+}
+
+bool TextManager::quadsDiffer(std::size_t text){
+
+    if (text + 1 >= _FIRST_QUADS.size() || _FIRST_QUADS[text+1] - _FIRST_QUADS[text] != _TEXTS[text]->getQuadCount())
+        return true;
+
+    for (std::size_t j = 0; j < _TEXTS[text]->getQuadCount(); j++){
+
+        if (std::memcmp(_TEXTS[text]->getQuadSprite(j)->getVBOData(),&_mainDataStorage[_FIRST_QUADS[text] + j],sizeof(vboData)) != 0)
+            return true;
     }
+
+    return false;
 }
 
 std::vector<std::shared_ptr<Text>>* TextManager::getMainTextStorage(){
@@ -226,16 +609,85 @@ std::vector<std::shared_ptr<Text>>* TextManager::getMainTextStorage(){
 
 void TextManager::updateVBOData(){
 
-    if (_mainDataStorage.size()!=0)
-        _mainDataStorage.clear();
+    if (!_rebuildAll){
+
+        for (std::size_t i = 0; i < _DIRTY_SLOTS.size() && !_rebuildAll; i++){
+
+            std::size_t slot = _DIRTY_SLOTS[i];
+
+            //New number of quads moves every following text
+            if (slot + 1 >= _FIRST_QUADS.size() || _FIRST_QUADS[slot+1] - _FIRST_QUADS[slot] != _TEXTS[slot]->getQuadCount())
+                _rebuildAll = true;
+        }
+    }
+
+    if (!_rebuildAll){
+
+        //Only the changed texts are written, at their slots
+        for (std::size_t i = 0; i < _DIRTY_SLOTS.size(); i++){
+
+            std::size_t slot = _DIRTY_SLOTS[i];
+
+            for (std::size_t j = 0; j < _TEXTS[slot]->getQuadCount(); j++)
+                _mainDataStorage[_FIRST_QUADS[slot] + j] = *(_TEXTS[slot]->getQuadSprite(j)->getVBOData());
+
+            _UPLOAD_SLOTS.push_back(slot);
+        }
+
+        _DIRTY_SLOTS.clear();
+
+        std::sort(_UPLOAD_SLOTS.begin(),_UPLOAD_SLOTS.end());
+        _UPLOAD_SLOTS.erase(std::unique(_UPLOAD_SLOTS.begin(),_UPLOAD_SLOTS.end()),_UPLOAD_SLOTS.end());
+
+        return;
+    }
+
+    _rebuildAll = false;
+    _uploadAll = true;
+    _DIRTY_SLOTS.clear();
+
+    //Overwriting in place - storage allocates only when the number of quads grows
+    _FIRST_QUADS.resize(_TEXTS.size() + 1);
+
+    std::size_t quads = 0;
+
+    for (std::size_t i = 0; i < _TEXTS.size(); i++){
+
+        _FIRST_QUADS[i] = quads;
+        quads += _TEXTS[i]->getQuadCount();
+    }
+
+    _FIRST_QUADS[_TEXTS.size()] = quads;
+
+    _mainDataStorage.resize(quads);
 
     for (std::size_t i = 0; i < _TEXTS.size(); i++){
-        _mainDataStorage.push_back(_TEXTS[i]->getVBOData());
+
+        for (std::size_t j = 0; j < _TEXTS[i]->getQuadCount(); j++)
+            _mainDataStorage[_FIRST_QUADS[i] + j] = *(_TEXTS[i]->getQuadSprite(j)->getVBOData());
     }
 }
 
 void TextManager::setFontSize(int size){
     _fontSize = size;
+
+    if (isSdfRendering()){
+
+        //Atlas stays, the font is only for the chars it doesn't have
+        TTF_CloseFont(_mainTextInfo.font);
+        _mainTextInfo.font = loadFont(PINGUI_DEFAULT_FONT_PATH,_fontSize);
+        _mainTextInfo.fontSize = _fontSize;
+        _mainTextInfo.digits.reset();
+
+        loadRasterizer();
+
+        _mainTextInfo.sdfScale = float(_fontSize) / float(PINGUI_SDF_BASE_SIZE);
+
+        reloadTexts();
+
+        return;
+    }
+
     loadTextInfo();
 }
 
@@ -265,7 +717,12 @@ textInfo* TextManager::getTextInfo(){
 }
 
 void TextManager::setUpdate(bool state){
+
     _needUpdate = state;
+
+    //Called from outside after changing the texts directly
+    if (state)
+        _rebuildAll = true;
 }
 
 void TextManager::normalizeText(const PinGUI::Vector2<GUIPos>& normalizationVector){
@@ -278,8 +735,21 @@ void TextManager::cropText(PinGUI::Rect& cropRect){
 
     for (std::size_t i = 0; i < _TEXTS.size(); i++){
 
-        if (!_TEXTS[i]->isNetworked())
-            CropManager::cropSprite(_TEXTS[i]->getSprite().get(),cropRect);
+        if (_TEXTS[i]->isNetworked())
+            continue;
+
+        CropManager::cropSprite(_TEXTS[i]->getSprite().get(),cropRect);
+
+        //Digit quads are drawn instead of the sprite, they're cropped one by one
+        if (_TEXTS[i]->getQuadSprite(0) != _TEXTS[i]->getSprite()){
+
+            for (std::size_t j = 0; j < _TEXTS[i]->getQuadCount(); j++)
+                CropManager::cropSprite(_TEXTS[i]->getQuadSprite(j).get(),cropRect);
+        }
+
+        //Mostly the crop gives the same quads as before, only the changed ones are written again
+        if (!_rebuildAll && quadsDiffer(i))
+            _DIRTY_SLOTS.push_back(i);
     }
 }
 
@@ -293,4 +763,9 @@ int TextManager::getFontSize(){
 
 void TextManager::immediateChangeText(std::shared_ptr<Text> text) {
 	text->immediateChange(&_mainTextInfo, _needUpdate);
-}
\ No newline at end of file
+
+	_DIRTY_SLOTS.push_back(text->getSlot());
+
+	if (PinGUI::DamageTracker::isEnabled())
+		_CHANGED_TEXTS.push_back(text->getSlot());
+}
\ No newline at end of file
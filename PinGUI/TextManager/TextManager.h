@@ -32,6 +32,7 @@
 #include <sstream>
 #include <algorithm>
 #include <memory>
+#include <mutex>
 
 #include <SDL_image.h>
 #include <SDL_ttf.h>
@@ -47,6 +48,21 @@
 #include "../CropManager.hpp"
 #include "../clFunction.hpp"
 #include "../CameraManager.h"
+#include "../AllocationTracker.h"
+#include "../DamageTracker.h"
+#include "../Shader_Program.h"
+
+#define PINGUI_DEFAULT_FONT_PATH "PinGUI/TextManager/Fonts/Oswald-Light.ttf"
+
+//Rasterized texts turned into textures in one frame, the rest waits for the next ones
+#define PINGUI_TEXT_UPLOADS_PER_FRAME 8
+
+//Font file in memory - either owned or pointing into the asset pack
+struct fontFileData{
+    const char* data = nullptr;
+    std::size_t size = 0;
+    std::vector<char> storage;
+};
 
 /**
     Main class
@@ -55,11 +71,20 @@ class TextManager
 {
     private:
 
+        //Font files kept in memory, every TextManager opens its font from here instead of the disk
+        static std::map<std::string, fontFileData> _FONT_FILES;
+
+        //Font files are shared by all PinGUI contexts
+        static std::mutex _fontMutex;
+
         //Storage variables
         std::vector<std::shared_ptr<Text>> _TEXTS;
 
         std::vector<vboData> _mainDataStorage;
 
+        //First quad of every text, numeric texts have a quad per char - one more entry for the end
+        std::vector<std::size_t> _FIRST_QUADS;
+
         std::shared_ptr<VBO_Manager> _textVBOManager;
 
         //Font stuff
@@ -71,16 +96,68 @@ class TextManager
 
         bool _moved;
 
+        //Text changed, vertex data have to be built again
+        bool _needRebuild;
+
+        //Vertex data are built and wait for the upload on the GL thread
+        bool _needUpload;
+
+        //Changed texts are rendered on the workers
+        bool _asyncRaster;
+
+        //Texts that changed since the last update - the others aren't checked at all
+        std::vector<Text*> _DIRTY_TEXTS;
+
+        //Dirty texts being checked, they may queue themselves again meanwhile
+        std::vector<Text*> _CHECKED_TEXTS;
+
+        //Texts whose quads changed in place, only their slots are written and uploaded
+        std::vector<std::size_t> _DIRTY_SLOTS;
+
+        std::vector<std::size_t> _UPLOAD_SLOTS;
+
+        //Texts were added or removed, or their number of quads changed
+        bool _rebuildAll;
+
+        bool _uploadAll;
+
+        //GUIManagers may share the TextManager and prepare it from different workers
+        std::mutex _prepareMutex;
+
+        //Damage tracking - data of the last upload, drawn visibility and texts changed since then
+        std::vector<vboData> _uploadedData;
+
+        std::vector<std::size_t> _uploadedFirstQuads;
+
+        std::vector<char> _drawnShown;
+
+        std::vector<std::size_t> _CHANGED_TEXTS;
+
+        //Grows with every change of the drawn image
+        uint64_t _revision;
+
         //Function to be called everytime when i update text ( useful for dynamic cropping )
         PinGUI::basicPointer _function;
 
         //Font stuff
         void loadTextInfo();
 
+        void loadRasterizer();
+
+        //Font size or text mode changed
+        void reloadTexts();
+
         //Functions for adding new text
+        std::shared_ptr<Text> addText(std::shared_ptr<Text> text);
+
         void checkForUpdate();
 
-        void removeData(std::size_t& position);
+        void removeInactiveTexts();
+
+        //Quads of the text differ from the built vertex data
+        bool quadsDiffer(std::size_t text);
+
+        void addTextDamage(const std::vector<vboData>& data, const std::vector<std::size_t>& firstQuads, std::size_t text);
 
         /**
             Manipulation with VBOs etc.
@@ -105,16 +182,48 @@ class TextManager
 
         TTF_Font* loadFont(const std::string& fontPath, int size);
 
+        //Reads the font file into memory - safe to run on a worker thread before any TextManager is created
+        static bool preloadFont(const std::string& fontPath);
+
+        //Uses font data that stays valid for the whole run (asset pack), nothing is copied
+        static void registerFont(const std::string& fontPath, const char* data, std::size_t size);
+
+        //Forgets the font data, fonts opened from it have to be closed already
+        static void releaseFont(const std::string& fontPath);
+
         void setColor(GLubyte R, GLubyte G, GLubyte B, GLubyte A);
 
         void setFontSize(int size);
 
         void setUpdate(bool state);
 
+        //On by default - changed texts keep their old look until a worker renders the new one
+        void setAsyncRasterization(bool state);
+
+        //Texts are drawn from one distance field atlas, a new font size then only scales them
+        void setSdfRendering(bool state);
+
+        bool isSdfRendering();
+
         void renderText();
 
         void updateText();
 
+        //Builds the vertex data without touching GL - safe to run on a worker
+        void prepareRender();
+
+        bool needPrepare();
+
+        //Uploads the prepared vertex data, damaged areas go to the DamageTracker
+        void upload();
+
+        //Upload plus the visibility changes of the texts, for the cached rendering modes
+        void refresh();
+
+        uint64_t getRevision();
+
+        const std::vector<vboData>& getVertexData();
+
         void cropText(PinGUI::Rect& cropRect);
 
         void normalizeText(const PinGUI::Vector2<GUIPos>& normalizationVector);
@@ -0,0 +1,68 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include "TextRasterizer.h"
+#include "../JobSystem.h"
+
+TextRasterizer::TextRasterizer(TTF_Font* font):
+    _font(std::make_shared<rasterFont>())
+{
+    _font->font = font;
+}
+
+TextRasterizer::~TextRasterizer()
+{
+    std::lock_guard<std::mutex> lock(_font->mutex);
+
+    if (_font->font)
+        TTF_CloseFont(_font->font);
+
+    _font->font = nullptr;
+}
+
+std::shared_ptr<rasterRequest> TextRasterizer::rasterize(const std::string& text, SDL_Color color){
+
+    auto request = std::make_shared<rasterRequest>();
+
+    request->text = text;
+    request->color = color;
+
+    std::shared_ptr<rasterFont> font = _font;
+
+    PinGUI::JobSystem::submit([font,request](){
+
+        {
+            std::lock_guard<std::mutex> lock(font->mutex);
+
+            //Text that changed again dropped the request, nobody waits for it
+            if (font->font && request.use_count() > 1)
+                request->surface = TTF_RenderText_Blended(font->font,request->text.c_str(),request->color);
+        }
+
+        request->done.store(true,std::memory_order_release);
+    });
+
+    return request;
+}
@@ -0,0 +1,79 @@
+#ifndef TEXTRASTERIZER_H
+#define TEXTRASTERIZER_H
+
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+#include <SDL_ttf.h>
+
+//Text waiting for its pixels from a worker
+struct rasterRequest{
+
+    std::string text;
+    SDL_Color color;
+
+    //Filled by the worker, nullptr in case the rendering failed
+    SDL_Surface* surface = nullptr;
+
+    std::atomic<bool> done{false};
+
+    ~rasterRequest(){
+        if (surface)
+            SDL_FreeSurface(surface);
+    }
+};
+
+/**
+    Renders texts into surfaces on the workers of the JobSystem
+    The GL thread creates the texture once the surface is done and keeps showing the old one till then
+**/
+class TextRasterizer
+{
+    private:
+
+        //SDL_ttf fonts can't be used by more threads at once, workers get their own instance
+        struct rasterFont{
+            TTF_Font* font = nullptr;
+            std::mutex mutex;
+        };
+
+        std::shared_ptr<rasterFont> _font;
+
+    public:
+        //Takes over the font, it has to be opened on the GL thread
+        TextRasterizer(TTF_Font* font);
+
+        //Closes the font on this thread, jobs still in the queue render nothing
+        ~TextRasterizer();
+
+        std::shared_ptr<rasterRequest> rasterize(const std::string& text, SDL_Color color);
+};
+
+#endif // TEXTRASTERIZER_H
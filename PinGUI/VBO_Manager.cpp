@@ -22,16 +22,51 @@
 
 **/
 
+
 #include "VBO_Manager.h"
 
-VBO_Manager::VBO_Manager(int limit, bool vao):
+thread_local uint64_t VBO_Manager::_uploadedBytes = 0;
+
+thread_local GLuint VBO_Manager::_indexBuffer = 0;
+
+thread_local int VBO_Manager::_indexQuads = 0;
+
+thread_local GLuint VBO_Manager::_arenaBuffer = 0;
+
+thread_local GLuint VBO_Manager::_arenaVAO = 0;
+
+thread_local PinGUI::BuddyAllocator VBO_Manager::_arena;
+
+thread_local int VBO_Manager::_drawBase = 0;
+
+void VBO_Manager::swapContext(contextState& state){
+
+    std::swap(_indexBuffer,state.indexBuffer);
+    std::swap(_indexQuads,state.indexQuads);
+    std::swap(_arenaBuffer,state.arenaBuffer);
+    std::swap(_arenaVAO,state.arenaVAO);
+    std::swap(_arena,state.arena);
+}
+
+VBO_Manager::VBO_Manager(int limit, bool vao, bool shared):
     _counter(1),
     _vboID(0),
-    _vaoID(0)
+    _vaoID(0),
+    _arenaOffset(-1)
 {
     _limit = limit;
     _staticLIMIT = limit;
 
+    if (shared){
+
+        //Range is rounded up to a power of two, the whole block is usable
+        _arenaOffset = allocateArena(limit);
+        _limit = _arena.getBlockSize(_arenaOffset);
+
+        reserveQuadIndices(_limit);
+        return;
+    }
+
     if (vao) createVAO();
 
     //Need to create the allocation first
@@ -41,73 +76,247 @@ VBO_Manager::VBO_Manager(int limit, bool vao):
 VBO_Manager::VBO_Manager():
     _counter(1),
     _vboID(0),
-    _vaoID(0)
+    _vaoID(0),
+    _arenaOffset(-1)
 {
 
 }
 
 VBO_Manager::~VBO_Manager()
 {
-    glDeleteBuffers(1,&_vboID);
+    if (_arenaOffset >= 0)
+        _arena.release(_arenaOffset);
+
+    PinGUI::GL_StateManager::deleteBuffer(_vboID);
+    PinGUI::GL_StateManager::deleteVertexArray(_vaoID);
 }
 
 void VBO_Manager::initMemory(const int& limit)
 {
-    glBindBuffer(GL_ARRAY_BUFFER,_vboID);
+    PinGUI::GL_StateManager::bindArrayBuffer(_vboID);
 
-    glBufferData(GL_ARRAY_BUFFER,limit*sizeof(vboData),nullptr,GL_DYNAMIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER,limit*PINGUI_BUFFER_QUAD_SIZE,nullptr,GL_DYNAMIC_DRAW);
 
-    glBindBuffer(GL_ARRAY_BUFFER,0);
+    PinGUI::GL_StateManager::bindArrayBuffer(0);
+
+    reserveQuadIndices(limit);
+}
+
+void VBO_Manager::reserveQuadIndices(int quads)
+{
+    if (_indexBuffer != 0 && quads <= _indexQuads)
+        return;
+
+    if (_indexBuffer == 0)
+        glGenBuffers(1,&_indexBuffer);
+
+    //Growing by the double, the indices are same for every buffer so they are only written here
+    _indexQuads = std::max(quads,_indexQuads*2);
+
+    std::vector<GLuint> indices(std::size_t(_indexQuads)*PINGUI_QUAD_INDICES);
+
+    for (int i = 0; i < _indexQuads; i++){
+
+        GLuint first = GLuint(i*PINGUI_QUAD_VERTICES);
+        GLuint* quad = &indices[std::size_t(i)*PINGUI_QUAD_INDICES];
+
+        quad[0] = first;
+        quad[1] = first + 1;
+        quad[2] = first + 2;
+        quad[3] = first + 2;
+        quad[4] = first + 3;
+        quad[5] = first;
+    }
+
+    //Element array binding belongs to the bound VAO, so the upload goes through the copy target
+    glBindBuffer(GL_COPY_WRITE_BUFFER,_indexBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER,indices.size()*sizeof(GLuint),indices.data(),GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER,0);
 }
 
 bool VBO_Manager::bufferData(int startPos, const std::vector<vboData>& dataVector)
+{
+    return bufferData(startPos,dataVector.data(),int(dataVector.size()));
+}
+
+bool VBO_Manager::bufferData(int startPos, const vboData* data, int count)
+{
+    bool tmp = false;
+
+    PinGUI::GL_StateManager::bindArrayBuffer(getVBO());
+
+    //In case of having small memory we need to resize our buffer for desirable amount - counted in quads
+    if (!canBuffer(startPos,count)){
+        addNewMemory(startPos+count);
+        tmp = true;
+    }
+
+    //vboData is only its 4 vertices, the quads are one array of vertices
+    uploadVertices(std::size_t(getBaseQuad() + startPos)*PINGUI_BUFFER_QUAD_SIZE,reinterpret_cast<const PinGUI::Vertex*>(data),std::size_t(count)*PINGUI_QUAD_VERTICES);
+
+    return tmp;
+}
+
+void VBO_Manager::uploadVertices(std::size_t offset, const PinGUI::Vertex* vertices, std::size_t count)
+{
+    _uploadedBytes += count*sizeof(PinGUI::BufferVertex);
+
+#ifdef PINGUI_COMPACT_VERTICES
+
+    _PACKED.resize(count);
+
+    for (std::size_t i = 0; i < count; i++)
+        _PACKED[i].pack(vertices[i]);
+
+    glBufferSubData(GL_ARRAY_BUFFER,offset,count*sizeof(PinGUI::CompactVertex),_PACKED.data());
+
+#else
+
+    glBufferSubData(GL_ARRAY_BUFFER,offset,count*sizeof(PinGUI::Vertex),vertices);
+
+#endif
+}
+
+bool VBO_Manager::bufferVertices(const std::vector<PinGUI::Vertex>& vertices)
 {
     bool tmp = false;
 
-    glBindBuffer(GL_ARRAY_BUFFER,_vboID);
-    startPos *= sizeof(vboData);
+    PinGUI::GL_StateManager::bindArrayBuffer(getVBO());
+
+    //Memory is counted in quads
+    int quads = int((vertices.size() + PINGUI_QUAD_VERTICES - 1) / PINGUI_QUAD_VERTICES);
 
-    //In case of having small memory we need to resize our buffer for desirable amount
-    if (!canBuffer(startPos,dataVector.size())){
-        addNewMemory();
+    if (!canBuffer(0,quads)){
+        addNewMemory(quads);
         tmp = true;
     }
 
-    glBufferSubData(GL_ARRAY_BUFFER,startPos,dataVector.size()*sizeof(vboData),dataVector.data());
+    uploadVertices(std::size_t(getBaseQuad())*PINGUI_BUFFER_QUAD_SIZE,vertices.data(),vertices.size());
 
     return tmp;
 }
 
-void VBO_Manager::addNewMemory(){
+void VBO_Manager::addNewMemory(int quads){
+
+    //Memory grows by the static limit, straight to the multiple that holds the quads
+    int step = std::max(1,_staticLIMIT);
+    _counter = std::max(_counter + 1,(quads + step - 1) / step);
+
+    if (_arenaOffset >= 0){
+
+        //Blocks are rounded up to a power of two - a move to a block of the same size would only copy
+        if (quads > _limit)
+            moveInArena(std::max(_staticLIMIT*_counter,quads));
+
+        return;
+    }
+
+    PinGUI::GL_StateManager::bindArrayBuffer(_vboID);
+    resizeBuffer(_limit*PINGUI_BUFFER_QUAD_SIZE,(_staticLIMIT*_counter)*PINGUI_BUFFER_QUAD_SIZE);
+
+    _limit = (_staticLIMIT*_counter);
+
+    reserveQuadIndices(_limit);
+}
+
+void VBO_Manager::resizeBuffer(std::size_t keptBytes, std::size_t newBytes){
     //At first need to make a tmp copy of my current Buffer to be sure that im not losing any of the inserted data
     GLuint tmpVBO = 0;
     glGenBuffers(1,&tmpVBO);
     glBindBuffer(GL_COPY_READ_BUFFER,tmpVBO);
 
     //Now allocate a memory for the copy
-    glBufferData(GL_COPY_READ_BUFFER,(_limit*_counter)*sizeof(vboData),nullptr,GL_STATIC_COPY);
+    glBufferData(GL_COPY_READ_BUFFER,keptBytes,nullptr,GL_STATIC_COPY);
+    glCopyBufferSubData(GL_ARRAY_BUFFER,GL_COPY_READ_BUFFER,0,0,keptBytes);
 
-    //Increment my counter
-    _counter++;
-
-    //Now resizing the right buffer and preparing it for copying
-    glBindBuffer(GL_ARRAY_BUFFER,_vboID);
-    glBufferData(GL_ARRAY_BUFFER,(_staticLIMIT*_counter)*sizeof(vboData),nullptr,GL_DYNAMIC_DRAW);
+    //Now resizing the right buffer, the name stays so the VAOs don't change
+    glBufferData(GL_ARRAY_BUFFER,newBytes,nullptr,GL_DYNAMIC_DRAW);
 
     //Copying
-    glCopyBufferSubData(GL_COPY_READ_BUFFER,GL_ARRAY_BUFFER,0,0,(_limit*(_counter-1))*sizeof(vboData));
+    glCopyBufferSubData(GL_COPY_READ_BUFFER,GL_ARRAY_BUFFER,0,0,keptBytes);
 
-    glDeleteBuffers(1,&tmpVBO);
+    PinGUI::GL_StateManager::deleteBuffer(tmpVBO);
     glBindBuffer(GL_COPY_READ_BUFFER,0);
-    _limit = (_staticLIMIT*_counter);
 }
 
+void VBO_Manager::moveInArena(int quads){
+
+    //New range first, the shared buffer may grow for it
+    int offset = allocateArena(quads);
+
+    PinGUI::GL_StateManager::bindArrayBuffer(_arenaBuffer);
+
+    //Ranges never overlap, so the copy stays in the buffer
+    glCopyBufferSubData(GL_ARRAY_BUFFER,GL_ARRAY_BUFFER,_arenaOffset*PINGUI_BUFFER_QUAD_SIZE,offset*PINGUI_BUFFER_QUAD_SIZE,_limit*PINGUI_BUFFER_QUAD_SIZE);
+
+    _arena.release(_arenaOffset);
+
+    _arenaOffset = offset;
+    _limit = _arena.getBlockSize(offset);
+
+    reserveQuadIndices(_limit);
+}
+
+int VBO_Manager::allocateArena(int quads){
+
+    initArena();
+
+    int offset = _arena.allocate(quads);
+
+    while (offset < 0){
+
+        std::size_t keptBytes = _arena.getCapacity()*PINGUI_BUFFER_QUAD_SIZE;
+
+        _arena.grow();
+
+        PinGUI::GL_StateManager::bindArrayBuffer(_arenaBuffer);
+        resizeBuffer(keptBytes,_arena.getCapacity()*PINGUI_BUFFER_QUAD_SIZE);
+
+        offset = _arena.allocate(quads);
+    }
+
+    return offset;
+}
+
+void VBO_Manager::initArena(){
+
+    if (_arenaBuffer != 0)
+        return;
+
+    _arena.reset(PINGUI_ARENA_QUADS);
+
+    glGenVertexArrays(1,&_arenaVAO);
+    PinGUI::GL_StateManager::bindVertexArray(_arenaVAO);
+
+    glGenBuffers(1,&_arenaBuffer);
+    PinGUI::GL_StateManager::bindArrayBuffer(_arenaBuffer);
+
+    glBufferData(GL_ARRAY_BUFFER,_arena.getCapacity()*PINGUI_BUFFER_QUAD_SIZE,nullptr,GL_DYNAMIC_DRAW);
+
+    reserveQuadIndices(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,_indexBuffer);
+
+    setAttributes();
+
+    PinGUI::GL_StateManager::bindArrayBuffer(0);
+
+    PinGUI::GL_StateManager::bindVertexArray(0);
+}
+
+int VBO_Manager::getBaseQuad(){
+    return (_arenaOffset >= 0) ? _arenaOffset : 0;
+}
 
 bool VBO_Manager::canBuffer(int startPos,int num){
+
+    //Range of the shared buffer is known without asking GL
+    if (_arenaOffset >= 0)
+        return _limit >= startPos+num;
+
     int tmp_size = 0;
 
     glGetBufferParameteriv(GL_ARRAY_BUFFER,GL_BUFFER_SIZE,&tmp_size);
-    tmp_size /= sizeof(vboData);
+    tmp_size /= PINGUI_BUFFER_QUAD_SIZE;
 
     if (tmp_size>=startPos+num)
         return true;
@@ -118,28 +327,79 @@ bool VBO_Manager::canBuffer(int startPos,int num){
 void VBO_Manager::createVAO()
 {
     if (_vaoID==0)glGenVertexArrays(1,&_vaoID);
-    glBindVertexArray(_vaoID);
+    PinGUI::GL_StateManager::bindVertexArray(_vaoID);
 
     if (_vboID==0) glGenBuffers(1,&_vboID);
-    glBindBuffer(GL_ARRAY_BUFFER,_vboID);
+    PinGUI::GL_StateManager::bindArrayBuffer(_vboID);
+
+    //Quads are drawn through the shared indices, the binding is stored in the VAO
+    reserveQuadIndices(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,_indexBuffer);
+
+    setAttributes();
+
+    PinGUI::GL_StateManager::bindArrayBuffer(0);
+
+    PinGUI::GL_StateManager::bindVertexArray(0);
+}
+
+void VBO_Manager::setAttributes()
+{
+#ifdef PINGUI_COMPACT_VERTICES
+
+    //Position - whole pixels, converted to floats by the vertex fetch
+    PinGUI::GL_StateManager::enableAttribute(0);
+    glVertexAttribPointer(0,2,GL_SHORT,GL_FALSE,sizeof(PinGUI::CompactVertex),(void*)offsetof(PinGUI::CompactVertex,x));
+
+    //Color attrib pointer
+    PinGUI::GL_StateManager::enableAttribute(1);
+    glVertexAttribPointer(1,4,GL_UNSIGNED_BYTE,GL_TRUE,sizeof(PinGUI::CompactVertex),(void*)offsetof(PinGUI::CompactVertex,color));
+
+    //UV - normalized back to 0..1
+    PinGUI::GL_StateManager::enableAttribute(2);
+    glVertexAttribPointer(2,2,GL_UNSIGNED_SHORT,GL_TRUE,sizeof(PinGUI::CompactVertex),(void*)offsetof(PinGUI::CompactVertex,u));
+
+#else
 
     //This is the position
-    glEnableVertexAttribArray(0);
+    PinGUI::GL_StateManager::enableAttribute(0);
     glVertexAttribPointer(0,2,GL_FLOAT,GL_FALSE,sizeof(PinGUI::Vertex),(void*)offsetof(PinGUI::Vertex,position));
 
     //Color attrib pointer
-    glEnableVertexAttribArray(1);
+    PinGUI::GL_StateManager::enableAttribute(1);
     glVertexAttribPointer(1,4,GL_UNSIGNED_BYTE,GL_TRUE,sizeof(PinGUI::Vertex),(void*)offsetof(PinGUI::Vertex,color));
 
     //UV
-    glEnableVertexAttribArray(2);
+    PinGUI::GL_StateManager::enableAttribute(2);
     glVertexAttribPointer(2,2,GL_FLOAT,GL_TRUE,sizeof(PinGUI::Vertex),(void*)offsetof(PinGUI::Vertex,uv));
 
-    glDisableVertexAttribArray(3);
+#endif
+
+    PinGUI::GL_StateManager::disableAttribute(3);
+}
+
+void VBO_Manager::bind()
+{
+    PinGUI::GL_StateManager::bindVertexArray(getVAO());
+
+    _drawBase = getBaseQuad();
+}
+
+VBO_Manager::boundState VBO_Manager::getBound(){
+
+    boundState state;
+
+    state.vertexArray = PinGUI::GL_StateManager::getVertexArray();
+    state.drawBase = _drawBase;
+
+    return state;
+}
+
+void VBO_Manager::restoreBound(const boundState& state){
 
-    glBindBuffer(GL_ARRAY_BUFFER,0);
+    PinGUI::GL_StateManager::bindVertexArray(state.vertexArray);
 
-    glBindVertexArray(0);
+    _drawBase = state.drawBase;
 }
 
 GLuint* VBO_Manager::getVBO_P()
@@ -149,14 +409,47 @@ GLuint* VBO_Manager::getVBO_P()
 
 GLuint VBO_Manager::getVBO()
 {
-    return _vboID;
+    return (_arenaOffset >= 0) ? _arenaBuffer : _vboID;
 }
 
 GLuint VBO_Manager::getVAO()
 {
-    return _vaoID;
+    return (_arenaOffset >= 0) ? _arenaVAO : _vaoID;
 }
 
 GLuint* VBO_Manager::getVAO_P(){
     return &_vaoID;
 }
+
+uint64_t VBO_Manager::getUploadedBytes(){
+    return _uploadedBytes;
+}
+
+std::size_t VBO_Manager::getVertexSize(){
+    return sizeof(PinGUI::BufferVertex);
+}
+
+void VBO_Manager::resetCounters(){
+    _uploadedBytes = 0;
+}
+
+void VBO_Manager::drawQuads(int first, int count){
+
+    glDrawElementsBaseVertex(GL_TRIANGLES,count*PINGUI_QUAD_INDICES,GL_UNSIGNED_INT,(void*)(std::size_t(first)*PINGUI_QUAD_INDICES*sizeof(GLuint)),_drawBase*PINGUI_QUAD_VERTICES);
+}
+
+void VBO_Manager::destroyShared(){
+
+    PinGUI::GL_StateManager::deleteBuffer(_indexBuffer);
+    _indexQuads = 0;
+
+    PinGUI::GL_StateManager::deleteBuffer(_arenaBuffer);
+    PinGUI::GL_StateManager::deleteVertexArray(_arenaVAO);
+
+    //Managers that outlive it don't find their ranges here anymore
+    _arena = PinGUI::BuddyAllocator();
+}
+
+PinGUI::allocatorStats VBO_Manager::getArenaStats(){
+    return _arena.getStats();
+}
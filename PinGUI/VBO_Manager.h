@@ -26,10 +26,19 @@
 **/
 
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <stddef.h>
 
 #include "stuff.h"
+#include "GL_StateManager.h"
+#include "BuddyAllocator.h"
+
+//Size of one quad in the buffer, depends on PINGUI_COMPACT_VERTICES
+#define PINGUI_BUFFER_QUAD_SIZE (PINGUI_QUAD_VERTICES*sizeof(PinGUI::BufferVertex))
+
+//Quads of the shared buffer at the start, it doubles when it's full
+#define PINGUI_ARENA_QUADS 4096
 
 class VBO_Manager
 {
@@ -42,30 +51,128 @@ class VBO_Manager
         GLuint _vboID;
         GLuint _vaoID;
 
+        //First quad of the range in the shared buffer, -1 for managers with their own buffer
+        int _arenaOffset;
+
+        //Vertices quantized for the upload, only with PINGUI_COMPACT_VERTICES
+        std::vector<PinGUI::CompactVertex> _PACKED;
+
+        //Bytes sent by all VBO_Managers since the last resetCounters
+        static thread_local uint64_t _uploadedBytes;
+
+        //Index buffer shared by all VAOs of the GL context - 0,1,2 2,3,0 for every quad
+        static thread_local GLuint _indexBuffer;
+
+        //Number of quads the index buffer covers
+        static thread_local int _indexQuads;
+
+        //Buffer and VAO shared by the managers created with the shared option, ranges are handed out by _arena
+        static thread_local GLuint _arenaBuffer;
+
+        static thread_local GLuint _arenaVAO;
+
+        static thread_local PinGUI::BuddyAllocator _arena;
+
+        //First quad of the manager bound by bind, added to the quads drawn by drawQuads
+        static thread_local int _drawBase;
+
         //Creation of VBO memory
         void initMemory(const int& limit);
 
         bool canBuffer(int startPos,int num);
 
-        void addNewMemory();
+        //Grows the memory to hold at least quads
+        void addNewMemory(int quads);
+
+        //Moves the data to a new range of the shared buffer with space for quads
+        void moveInArena(int quads);
+
+        //Quad of the buffer where the data of this manager start
+        int getBaseQuad();
+
+        //Vertex format of the bound VAO for the bound buffer
+        static void setAttributes();
+
+        //Resizes the bound array buffer, the first bytes of the data stay
+        static void resizeBuffer(std::size_t keptBytes, std::size_t newBytes);
+
+        //Range of the shared buffer, the buffer grows when there isn't a free one
+        static int allocateArena(int quads);
+
+        static void initArena();
+
+        //Uploads count vertices at the byte offset, in the buffer format
+        void uploadVertices(std::size_t offset, const PinGUI::Vertex* vertices, std::size_t count);
+
+        //Grows the shared index buffer, the name stays so VAOs keep their binding
+        static void reserveQuadIndices(int quads);
 
     public:
-        VBO_Manager(int limit, bool vao = true);
+
+        //Index buffer and shared buffer of one PinGUI::Context
+        struct contextState{
+            GLuint indexBuffer = 0;
+            int indexQuads = 0;
+            GLuint arenaBuffer = 0;
+            GLuint arenaVAO = 0;
+            PinGUI::BuddyAllocator arena;
+        };
+
+        //VAO and draw base, for restoring them after drawing with another manager
+        struct boundState{
+            GLuint vertexArray = 0;
+            int drawBase = 0;
+        };
+
+        static void swapContext(contextState& state);
+
+        //Shared managers take a range of one buffer of the context and draw through its VAO
+        VBO_Manager(int limit, bool vao = true, bool shared = false);
         VBO_Manager();
         ~VBO_Manager();
 
         //Buffering the data
         bool bufferData(int startPos, const std::vector<vboData>& dataVector);
 
+        //Part of the data - count quads from startPos
+        bool bufferData(int startPos, const vboData* data, int count);
+
+        //Loose vertices for other primitives than quads (lines of plots), written from the start of the buffer
+        bool bufferVertices(const std::vector<PinGUI::Vertex>& vertices);
+
         //Creation of VAOs
         void createVAO();
         GLuint createVAO(GLuint* vboID);
 
+        //Binds the VAO, drawQuads then counts the quads from the start of this manager
+        void bind();
+
+        static boundState getBound();
+
+        static void restoreBound(const boundState& state);
+
+        bool isShared(){return _arenaOffset >= 0;}
+
         GLuint* getVBO_P();
         GLuint getVBO();
         GLuint getVAO();
         GLuint* getVAO_P();
 
+        //For comparing the vertex formats - upload bandwidth, and vertex fetch as the size of one vertex
+        static uint64_t getUploadedBytes();
+
+        static std::size_t getVertexSize();
+
+        static void resetCounters();
+
+        //Draws count quads from the first one of the currently bound VAO
+        static void drawQuads(int first, int count = 1);
+
+        //Deletes the index buffer and the shared buffer, has to run while the GL context is current
+        static void destroyShared();
+
+        //Usage and fragmentation of the shared buffer, in quads
+        static PinGUI::allocatorStats getArenaStats();
 
 };
 
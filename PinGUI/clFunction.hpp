@@ -89,6 +89,20 @@ namespace PinGUI{
             }
     };
 
+    //Writes the text of one table cell into the passed string
+    class tableFuncPointer{
+          public :
+            std::function<void(std::size_t row, std::size_t column, std::string& text)> _function;
+
+            void exec(std::size_t row, std::size_t column, std::string& text){
+
+                if (_function){
+
+                    _function(row,column,text);
+                }
+            }
+    };
+
     class stringFuncPointer{
           public :
             std::function<void(std::string text)> _function;
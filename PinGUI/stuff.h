@@ -32,6 +32,10 @@
 
 #include "GL_Vertex.h"
 
+class DigitStrip;
+class TextRasterizer;
+class SdfAtlas;
+
 class textInfo{
 public:
     textInfo(TTF_Font* Font,SDL_Color Color):
@@ -48,10 +52,28 @@ public:
 
     TTF_Font* font;  
     SDL_Color color;
+
+    //Size of the default font, its glyphs can come from the asset pack. 0 for other fonts
+    int fontSize = 0;
+
+    //Prebaked numeric glyphs of this font and color, built with the first numeric text
+    std::shared_ptr<DigitStrip> digits;
+
+    //Renders changed texts on the workers, without it they are rendered right away
+    std::shared_ptr<TextRasterizer> rasterizer;
+
+    //SDF mode - texts are quads into the atlas, scaled to the font size
+    std::shared_ptr<SdfAtlas> sdf;
+
+    float sdfScale = 1.0f;
 };
 
+//Quad is top right, top left, bottom left, bottom right - triangles come from the index buffer of VBO_Manager
+#define PINGUI_QUAD_VERTICES 4
+#define PINGUI_QUAD_INDICES 6
+
 struct vboData{
-    PinGUI::Vertex vertices[6];
+    PinGUI::Vertex vertices[PINGUI_QUAD_VERTICES];
 };
 
 /**
@@ -0,0 +1,318 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+/**
+    Offline packer of the PinGUI startup assets
+
+    Bakes the sliced sheet regions, glyph atlases of the default font, the shader sources
+    and the font file into one binary pack, which PINGUI::initLibrary maps instead of
+    decoding the PNG sheets
+
+    Run it from the directory that contains PinGUI/ :
+        AssetPacker [output file] [font sizes...]
+    Defaults are PINGUI_ASSET_PACK_PATH and font sizes 14 and PINGUI_SDF_BASE_SIZE
+    Numeric glyph strips and the SDF atlas take their glyphs from the atlas of the matching size
+**/
+
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_ttf.h>
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+#include "PinGUI/SheetManager.h"
+#include "PinGUI/AssetPack.h"
+#include "PinGUI/Shader_Program.h"
+#include "PinGUI/TextManager/TextManager.h"
+
+#define PACKER_ATLAS_WIDTH 256
+
+#define PACKER_FIRST_CHAR 32
+#define PACKER_LAST_CHAR 126
+
+struct pendingEntry{
+    PinGUI::packEntry entry;
+    std::vector<uint8_t> data;
+};
+
+static bool readFile(const std::string& filePath, std::vector<uint8_t>& data){
+
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+
+    if (file.fail())
+        return false;
+
+    std::streamsize size = file.tellg();
+    file.seekg(0,std::ios::beg);
+
+    data.resize(static_cast<std::size_t>(size));
+
+    return bool(file.read(reinterpret_cast<char*>(data.data()),size));
+}
+
+//Copies the surface as tightly packed RGBA32 pixels
+static void copyPixels(SDL_Surface* surface, std::vector<uint8_t>& data, std::size_t offset = 0){
+
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface,SDL_PIXELFORMAT_RGBA32,0);
+
+    if (!converted)
+        ErrorManager::systemError(SDL_GetError());
+
+    const uint8_t* pixels = static_cast<const uint8_t*>(converted->pixels);
+
+    for (int y = 0; y < converted->h; y++)
+        std::memcpy(&data[offset + std::size_t(y)*converted->w*4],pixels + std::size_t(y)*converted->pitch,std::size_t(converted->w)*4);
+
+    SDL_FreeSurface(converted);
+}
+
+static void addSurfaces(const std::vector<SDL_Surface*>& surfaces, std::vector<pendingEntry>& entries){
+
+    for (std::size_t i = 0; i < surfaces.size(); i++){
+
+        pendingEntry tmp;
+        tmp.entry.type = PinGUI::PACK_SURFACE;
+        tmp.entry.id = uint32_t(i);
+        tmp.entry.width = uint32_t(surfaces[i]->w);
+        tmp.entry.height = uint32_t(surfaces[i]->h);
+
+        tmp.data.resize(std::size_t(surfaces[i]->w)*surfaces[i]->h*4);
+        copyPixels(surfaces[i],tmp.data);
+
+        entries.push_back(tmp);
+    }
+}
+
+static void addGlyphAtlas(int fontSize, std::vector<pendingEntry>& entries){
+
+    TTF_Font* font = TTF_OpenFont(PINGUI_DEFAULT_FONT_PATH,fontSize);
+
+    if (!font)
+        ErrorManager::fileError(PINGUI_DEFAULT_FONT_PATH);
+
+    SDL_Color white = {255,255,255,255};
+
+    const uint32_t numOfGlyphs = PACKER_LAST_CHAR - PACKER_FIRST_CHAR + 1;
+
+    std::vector<SDL_Surface*> glyphSurfaces(numOfGlyphs,nullptr);
+    std::vector<PinGUI::packGlyph> glyphs(numOfGlyphs);
+
+    //Simple shelf packing
+    int x = 0, y = 0, rowHeight = 0;
+
+    for (uint32_t i = 0; i < numOfGlyphs; i++){
+
+        Uint16 ch = Uint16(PACKER_FIRST_CHAR + i);
+
+        int minX, maxX, minY, maxY, advance;
+        TTF_GlyphMetrics(font,ch,&minX,&maxX,&minY,&maxY,&advance);
+
+        glyphSurfaces[i] = TTF_RenderGlyph_Blended(font,ch,white);
+
+        PinGUI::packGlyph& glyph = glyphs[i];
+        std::memset(&glyph,0,sizeof(glyph));
+        glyph.advance = int16_t(advance);
+
+        if (!glyphSurfaces[i])
+            continue;
+
+        if (x + glyphSurfaces[i]->w > PACKER_ATLAS_WIDTH){
+
+            x = 0;
+            y += rowHeight + 1;
+            rowHeight = 0;
+        }
+
+        glyph.x = uint16_t(x);
+        glyph.y = uint16_t(y);
+        glyph.w = uint16_t(glyphSurfaces[i]->w);
+        glyph.h = uint16_t(glyphSurfaces[i]->h);
+
+        x += glyphSurfaces[i]->w + 1;
+
+        if (glyphSurfaces[i]->h > rowHeight)
+            rowHeight = glyphSurfaces[i]->h;
+    }
+
+    int atlasHeight = y + rowHeight;
+
+    PinGUI::packGlyphAtlas info;
+    info.firstChar = PACKER_FIRST_CHAR;
+    info.numOfGlyphs = numOfGlyphs;
+    info.lineHeight = TTF_FontHeight(font);
+    info.ascent = TTF_FontAscent(font);
+
+    std::size_t pixelsOffset = PinGUI::AssetPack::alignOffset(sizeof(info) + numOfGlyphs*sizeof(PinGUI::packGlyph));
+
+    pendingEntry tmp;
+    tmp.entry.type = PinGUI::PACK_GLYPH_ATLAS;
+    tmp.entry.id = uint32_t(fontSize);
+    tmp.entry.width = PACKER_ATLAS_WIDTH;
+    tmp.entry.height = uint32_t(atlasHeight);
+    tmp.data.assign(pixelsOffset + std::size_t(PACKER_ATLAS_WIDTH)*atlasHeight*4,0);
+
+    std::memcpy(tmp.data.data(),&info,sizeof(info));
+    std::memcpy(tmp.data.data()+sizeof(info),glyphs.data(),numOfGlyphs*sizeof(PinGUI::packGlyph));
+
+    //Glyph surfaces go row by row into the atlas
+    for (uint32_t i = 0; i < numOfGlyphs; i++){
+
+        if (!glyphSurfaces[i])
+            continue;
+
+        std::vector<uint8_t> glyphPixels(std::size_t(glyphs[i].w)*glyphs[i].h*4);
+        copyPixels(glyphSurfaces[i],glyphPixels);
+
+        for (int row = 0; row < glyphs[i].h; row++){
+
+            std::size_t dst = pixelsOffset + (std::size_t(glyphs[i].y + row)*PACKER_ATLAS_WIDTH + glyphs[i].x)*4;
+            std::memcpy(&tmp.data[dst],&glyphPixels[std::size_t(row)*glyphs[i].w*4],std::size_t(glyphs[i].w)*4);
+        }
+
+        SDL_FreeSurface(glyphSurfaces[i]);
+    }
+
+    TTF_CloseFont(font);
+
+    entries.push_back(tmp);
+}
+
+static void addFile(PinGUI::packEntryType type, uint32_t id, const std::string& filePath, std::vector<pendingEntry>& entries){
+
+    pendingEntry tmp;
+    tmp.entry.type = type;
+    tmp.entry.id = id;
+    tmp.entry.width = 0;
+    tmp.entry.height = 0;
+
+    if (!readFile(filePath,tmp.data))
+        ErrorManager::fileError(filePath);
+
+    entries.push_back(tmp);
+}
+
+static bool writePack(const std::string& filePath, std::vector<pendingEntry>& entries, uint32_t numOfSurfaces){
+
+    PinGUI::packHeader header;
+    header.magic = PINGUI_PACK_MAGIC;
+    header.version = PINGUI_PACK_VERSION;
+    header.numOfEntries = uint32_t(entries.size());
+    header.numOfSurfaces = numOfSurfaces;
+
+    //Data blocks start behind the entry table
+    std::size_t offset = PinGUI::AssetPack::alignOffset(sizeof(header) + entries.size()*sizeof(PinGUI::packEntry));
+
+    for (std::size_t i = 0; i < entries.size(); i++){
+
+        entries[i].entry.offset = offset;
+        entries[i].entry.size = entries[i].data.size();
+
+        offset = PinGUI::AssetPack::alignOffset(offset + entries[i].data.size());
+    }
+
+    std::ofstream file(filePath, std::ios::binary);
+
+    if (file.fail())
+        return false;
+
+    file.write(reinterpret_cast<const char*>(&header),sizeof(header));
+
+    for (std::size_t i = 0; i < entries.size(); i++)
+        file.write(reinterpret_cast<const char*>(&entries[i].entry),sizeof(PinGUI::packEntry));
+
+    for (std::size_t i = 0; i < entries.size(); i++){
+
+        //Padding up to the aligned offset
+        std::size_t position = std::size_t(file.tellp());
+        std::vector<char> padding(std::size_t(entries[i].entry.offset) - position,0);
+
+        if (!padding.empty())
+            file.write(padding.data(),std::streamsize(padding.size()));
+
+        file.write(reinterpret_cast<const char*>(entries[i].data.data()),std::streamsize(entries[i].data.size()));
+    }
+
+    return file.good();
+}
+
+int main(int argc, char** args){
+
+    std::string outputPath = (argc > 1) ? args[1] : PINGUI_ASSET_PACK_PATH;
+
+    std::vector<int> fontSizes;
+
+    for (int i = 2; i < argc; i++)
+        fontSizes.push_back(std::atoi(args[i]));
+
+    if (fontSizes.empty()){
+
+        fontSizes.push_back(14);
+        fontSizes.push_back(PINGUI_SDF_BASE_SIZE);
+    }
+
+    if (TTF_Init() != 0)
+        ErrorManager::systemError("Failed to init TTF");
+
+    IMG_Init(IMG_INIT_PNG);
+
+    //Same slicing as at runtime, so the regions are identical
+    std::vector<SDL_Surface*> surfaces;
+
+    if (!SheetManager::loadMainSheet(surfaces))
+        ErrorManager::fileError(PINGUI_MAIN_SHEET_PATH);
+
+    if (!SheetManager::loadWindowTextures(surfaces))
+        ErrorManager::fileError(PINGUI_WINDOW_SHEET_PATH);
+
+    std::vector<pendingEntry> entries;
+
+    addSurfaces(surfaces,entries);
+
+    for (std::size_t i = 0; i < fontSizes.size(); i++)
+        addGlyphAtlas(fontSizes[i],entries);
+
+    addFile(PinGUI::PACK_SHADER,PinGUI::PACK_VERTEX_SHADER,PINGUI_VERTEX_SHADER_PATH,entries);
+    addFile(PinGUI::PACK_SHADER,PinGUI::PACK_FRAGMENT_SHADER,PINGUI_FRAGMENT_SHADER_PATH,entries);
+    addFile(PinGUI::PACK_SHADER,PinGUI::PACK_SDF_FRAGMENT_SHADER,PINGUI_SDF_FRAGMENT_SHADER_PATH,entries);
+    addFile(PinGUI::PACK_FONT,0,PINGUI_DEFAULT_FONT_PATH,entries);
+
+    if (!writePack(outputPath,entries,uint32_t(surfaces.size())))
+        ErrorManager::fileError(outputPath);
+
+    std::cout << "Packed " << entries.size() << " entries into " << outputPath << std::endl;
+
+    for (std::size_t i = 0; i < surfaces.size(); i++)
+        SDL_FreeSurface(surfaces[i]);
+
+    TTF_Quit();
+    IMG_Quit();
+
+    return 0;
+}
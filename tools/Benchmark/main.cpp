@@ -0,0 +1,439 @@
+/**
+
+    PinGUI
+
+    Copyright (c) 2017 Lubomir Barantal <l.pinsius@gmail.com>
+
+    This software is provided 'as-is', without any express or implied
+    warranty. In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+       claim that you wrote the original software. If you use this software
+       in a product, an acknowledgment in the product documentation would be
+       appreciated but is not required.
+    2. Altered source versions must be plainly marked as such, and must not be
+       misrepresented as being the original software.
+    3. This notice may not be removed or altered from any source distribution.
+
+**/
+
+
+
+/**
+    Benchmark of the PinGUI frame paths
+
+    Opens a hidden SDL window with an OpenGL context, builds a GUI and runs the scenarios
+    below on it. Each scenario prints its numbers, the ones with a check print FAIL and the
+    program returns 1, so it can guard a build
+
+    Build it with PINGUI_TRACK_ALLOCATIONS defined, otherwise the allocation counters stay at zero
+    Build with PINGUI_COMPACT_VERTICES too to get the upload numbers of the compact vertex format
+    Run it from the directory that contains PinGUI/ :
+        Benchmark [frames]
+    Default is BENCH_DEFAULT_FRAMES measured frames per scenario
+**/
+
+#include <SDL.h>
+#include <GL/glew.h>
+
+#include <chrono>
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <memory>
+
+#include "PinGUI/PINGUI.h"
+#include "PinGUI/AllocationTracker.h"
+#include "PinGUI/JobSystem.h"
+#include "PinGUI/VBO_Manager.h"
+#include "PinGUI/SpriteStore.h"
+
+#define BENCH_DEFAULT_FRAMES 300
+
+//Frames rendered before measuring - first frames build the vertex data and load the textures
+#define BENCH_WARMUP_FRAMES 10
+
+#define BENCH_SCREEN_WIDTH 1024
+#define BENCH_SCREEN_HEIGHT 768
+
+//Labels changed at once - their rasters fill the job queue of the render frame
+#define BENCH_PENDING_RASTERS 1000
+
+//Elements of the large window, laid out in rows of BENCH_LARGE_COLUMNS
+#define BENCH_LARGE_ELEMENTS 10000
+#define BENCH_LARGE_COLUMNS 100
+
+static SDL_Window* _window = nullptr;
+
+static int _frames = BENCH_DEFAULT_FRAMES;
+
+static bool _failed = false;
+
+static int _sliderValue = 0;
+static bool _checked = true;
+
+static std::vector<std::string> _LABELS;
+
+static std::shared_ptr<Window> _largeWindow = nullptr;
+
+//Variables of the check boxes in the large window
+static std::unique_ptr<bool[]> _LARGE_CHECKS;
+
+static double elapsedMs(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double,std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool initContext(){
+
+    if (SDL_Init(SDL_INIT_VIDEO) != 0 || TTF_Init() != 0){
+
+        std::cout << "Failed to init SDL: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    IMG_Init(IMG_INIT_PNG);
+
+    SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+
+    _window = SDL_CreateWindow("PinGUI_Benchmark", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+                               BENCH_SCREEN_WIDTH, BENCH_SCREEN_HEIGHT, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+
+    if (!_window || !SDL_GL_CreateContext(_window)){
+
+        std::cout << "Failed to create the GL context: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    if (glewInit() != GLEW_OK){
+
+        std::cout << "Failed to init GLEW" << std::endl;
+        return false;
+    }
+
+    //Measured frames mustn't wait for the display
+    SDL_GL_SetSwapInterval(0);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    return true;
+}
+
+static void runFrame(SDL_Event* event = nullptr){
+
+    PINGUI::processInput(event);
+    PINGUI::update();
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    PINGUI::render();
+
+    SDL_GL_SwapWindow(_window);
+}
+
+static void check(bool passed, const std::string& what){
+
+    std::cout << (passed ? "  ok   " : "  FAIL ") << what << std::endl;
+
+    if (!passed)
+        _failed = true;
+}
+
+//Window with the usual elements, the same as the demo has
+static void createGUI(){
+
+    windowDef windowDefinition(PinGUI::Rect(200, 200, 400, 400), {"Main"}, BOTH);
+    windowDefinition.windowName = "Benchmark window";
+
+    PINGUI::createWindow(&windowDefinition);
+
+    PINGUI::bindTab("Main");
+
+    PINGUI::GUI->createVolumeBoard(20, 90, true, &_sliderValue, 1000);
+    PINGUI::GUI->createArrowBoard(65, 175, &_sliderValue, 1000, true, 0, PinGUI::HORIZONTAL);
+    PINGUI::GUI->createClipBoard(55, 55, NORMAL, 28, ROUNDED);
+    PINGUI::GUI->createCheckBox(10, 50, &_checked);
+
+    PINGUI::TEXT->writeText("Benchmark", 105, 25);
+
+    PINGUI::resetGUI();
+
+    PINGUI::normalize();
+}
+
+//Window with BENCH_LARGE_ELEMENTS check boxes, created once for the scenarios that need a large scene
+static void createLargeGUI(){
+
+    if (_largeWindow)
+        return;
+
+    windowDef windowDefinition(PinGUI::Rect(50, 50, 900, 650), {"Large"}, BOTH);
+    windowDefinition.windowName = "Large window";
+
+    PINGUI::createWindow(&windowDefinition);
+
+    PINGUI::bindTab("Large");
+
+    _LARGE_CHECKS.reset(new bool[BENCH_LARGE_ELEMENTS]());
+
+    for (int i = 0; i < BENCH_LARGE_ELEMENTS; i++)
+        PINGUI::GUI->createCheckBox(GUIPos(10 + (i % BENCH_LARGE_COLUMNS) * 20), GUIPos(10 + (i / BENCH_LARGE_COLUMNS) * 20), &_LARGE_CHECKS[i]);
+
+    PINGUI::resetGUI();
+
+    //The first window is normalized already
+    _largeWindow = PINGUI::getWindow("Large window");
+    _largeWindow->normalize();
+}
+
+/**
+    Scenarios
+**/
+
+//Idle and hover frames must not touch the heap
+static void allocationScenario(){
+
+    std::cout << "Allocations per frame" << std::endl;
+
+    if (!PinGUI::AllocationTracker::isEnabled()){
+
+        std::cout << "  skipped - built without PINGUI_TRACK_ALLOCATIONS" << std::endl;
+        return;
+    }
+
+    for (int i = 0; i < BENCH_WARMUP_FRAMES; i++)
+        runFrame();
+
+    std::size_t idleFrames = 0, idleMax = 0;
+
+    for (int i = 0; i < _frames; i++){
+
+        runFrame();
+
+        std::size_t count = PinGUI::AllocationTracker::getLastFrame().getTotalAllocations();
+
+        idleFrames += (count > 0);
+        idleMax = std::max(idleMax,count);
+    }
+
+    std::cout << "  idle: " << idleFrames << " of " << _frames << " frames allocated, at most " << idleMax << std::endl;
+
+    check(idleFrames == 0, "idle frames allocate nothing");
+
+    //Cursor moving over the window - aiming and leaving the elements
+    std::size_t hoverFrames = 0, hoverMax = 0;
+
+    for (int i = 0; i < _frames; i++){
+
+        SDL_Event event = {};
+        event.type = SDL_MOUSEMOTION;
+        event.motion.x = 220 + (i * 7) % 360;
+        event.motion.y = 220 + (i * 3) % 360;
+
+        SDL_WarpMouseInWindow(_window, event.motion.x, event.motion.y);
+
+        runFrame(&event);
+
+        //Aiming an element for the first time may prepare its state once
+        if (i < BENCH_WARMUP_FRAMES)
+            continue;
+
+        std::size_t count = PinGUI::AllocationTracker::getLastFrame().getTotalAllocations();
+
+        hoverFrames += (count > 0);
+        hoverMax = std::max(hoverMax,count);
+    }
+
+    std::cout << "  hover: " << hoverFrames << " frames allocated, at most " << hoverMax << std::endl;
+
+    PinGUI::AllocationTracker::info();
+
+    check(hoverFrames == 0, "hover frames allocate nothing");
+}
+
+//GUIManagers are built by parallelFor while the text rasters wait in the queue - the frame mustn't wait for them
+static void rasterScenario(){
+
+    std::cout << "Render with pending rasters" << std::endl;
+
+    std::shared_ptr<GUIManager> managers[2] = {PINGUI::getGUI(), PINGUI::getWindow("Benchmark window")->getGUI()};
+
+    _LABELS.assign(BENCH_PENDING_RASTERS, "Label");
+
+    for (std::size_t i = 0; i < _LABELS.size(); i++)
+        managers[i % 2]->getTextManager()->writeText(GUIPos(10 + (i / 2) % 10 * 90), GUIPos(10 + (i / 20) * 14), &_LABELS[i]);
+
+    for (int i = 0; i < BENCH_WARMUP_FRAMES; i++)
+        runFrame();
+
+    //Job queue is FIFO, so this returns once the rasters queued before are done
+    PinGUI::JobSystem::submit([](){}).wait();
+
+    int rounds = std::max(1, _frames / 10);
+
+    double renderMax = 0.0, drainMs = 0.0;
+
+    for (int i = 0; i < rounds; i++){
+
+        for (std::size_t j = 0; j < _LABELS.size(); j++)
+            _LABELS[j] = "Label " + std::to_string(i * 1000 + int(j));
+
+        //Update queues the rasters
+        PINGUI::processInput();
+        PINGUI::update();
+
+        //Both managers have something to build, so the render goes through parallelFor
+        managers[0]->setUpdate(true);
+        managers[1]->setUpdate(true);
+
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        auto renderStart = std::chrono::steady_clock::now();
+
+        PINGUI::render();
+
+        renderMax = std::max(renderMax, elapsedMs(renderStart));
+
+        SDL_GL_SwapWindow(_window);
+
+        auto drainStart = std::chrono::steady_clock::now();
+
+        PinGUI::JobSystem::submit([](){}).wait();
+
+        drainMs += elapsedMs(drainStart);
+    }
+
+    drainMs /= rounds;
+
+    std::cout << "  " << BENCH_PENDING_RASTERS << " rasters: render at most " << renderMax << " ms, rest of the queue " << drainMs << " ms" << std::endl;
+
+    check(renderMax < drainMs, "render doesn't wait for the queued rasters");
+}
+
+//Vertex bytes uploaded while the large window moves - compare with sizeof(PinGUI::Vertex) for the float format
+static void uploadScenario(){
+
+    std::cout << "Vertex upload of the large window" << std::endl;
+
+    createLargeGUI();
+
+    for (int i = 0; i < BENCH_WARMUP_FRAMES; i++)
+        runFrame();
+
+    VBO_Manager::resetCounters();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < _frames; i++){
+
+        //Back and forth, so the window stays on the screen
+        _largeWindow->moveWindow(PinGUI::Vector2<GUIPos>(i % 2 == 0 ? 1.0f : -1.0f, 0.0f));
+
+        runFrame();
+    }
+
+    double frameMs = elapsedMs(start) / _frames;
+
+    uint64_t bytes = VBO_Manager::getUploadedBytes() / uint64_t(_frames);
+    uint64_t vertices = bytes / VBO_Manager::getVertexSize();
+    uint64_t floatBytes = vertices * sizeof(PinGUI::Vertex);
+
+    std::cout << "  " << VBO_Manager::getVertexSize() << " bytes per vertex, " << vertices << " vertices per frame" << std::endl;
+    std::cout << "  uploaded " << bytes << " bytes per frame, " << floatBytes << " with float vertices ("
+              << (floatBytes > 0 ? 100.0 * double(bytes) / double(floatBytes) : 100.0) << " %)" << std::endl;
+    std::cout << "  " << frameMs << " ms per frame" << std::endl;
+
+    check(vertices > 0, "moved window uploads its vertices");
+}
+
+//Average ms of the frames with the step applied before each of them
+template<typename F>
+static double timeFrames(F step){
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < _frames; i++){
+
+        step(i);
+        runFrame();
+    }
+
+    return elapsedMs(start) / _frames;
+}
+
+//Moves and fades of the large window go through the sprite store, compared with rebuilding the vertex data from the sprites
+static void moveFadeScenario(){
+
+    std::cout << "Move and fade of " << BENCH_LARGE_ELEMENTS << " elements (sprite store lanes: " << PinGUI::SpriteStore::getLaneCount() << ")" << std::endl;
+
+    createLargeGUI();
+
+    std::shared_ptr<GUIManager> tabGUI = _largeWindow->getTab("Large")->getGUI();
+
+    for (int i = 0; i < BENCH_WARMUP_FRAMES; i++)
+        runFrame();
+
+    auto move = [](int i){
+        _largeWindow->moveWindow(PinGUI::Vector2<GUIPos>(i % 2 == 0 ? 1.0f : -1.0f, 0.0f));
+    };
+
+    auto fade = [](int i){
+        _largeWindow->setAlpha(Uint8(255 - i % 128));
+    };
+
+    double moveMs = timeFrames(move);
+
+    //Forced update builds the vertex data from the sprites, which is what the moves did before the store
+    double moveRebuildMs = timeFrames([&](int i){ move(i); tabGUI->setUpdate(true); });
+
+    double fadeMs = timeFrames(fade);
+
+    double fadeRebuildMs = timeFrames([&](int i){ fade(i); tabGUI->setUpdate(true); });
+
+    _largeWindow->setAlpha(255);
+    runFrame();
+
+    std::cout << "  move: " << moveMs << " ms per frame, " << moveRebuildMs << " ms with rebuilds (" << moveRebuildMs / moveMs << "x)" << std::endl;
+    std::cout << "  fade: " << fadeMs << " ms per frame, " << fadeRebuildMs << " ms with rebuilds (" << fadeRebuildMs / fadeMs << "x)" << std::endl;
+
+    check(moveMs < moveRebuildMs, "moving through the store is faster than rebuilding");
+    check(fadeMs < fadeRebuildMs, "fading through the store is faster than rebuilding");
+}
+
+int main(int argc, char** args){
+
+    if (argc > 1)
+        _frames = std::max(1,std::atoi(args[1]));
+
+    if (!initContext())
+        return 1;
+
+    PINGUI::initLibrary(BENCH_SCREEN_WIDTH, BENCH_SCREEN_HEIGHT);
+
+    createGUI();
+
+    auto start = std::chrono::steady_clock::now();
+
+    allocationScenario();
+
+    rasterScenario();
+
+    uploadScenario();
+
+    moveFadeScenario();
+
+    std::cout << "Done in " << elapsedMs(start) << " ms" << std::endl;
+
+    PINGUI::destroy();
+
+    SDL_Quit();
+
+    return _failed ? 1 : 0;
+}